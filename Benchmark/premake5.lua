@@ -0,0 +1,28 @@
+project "Benchmark"  
+    kind "ConsoleApp" 
+    language "C++"
+    cppdialect "C++17"
+    staticruntime "off"
+
+    targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+    
+    files {
+        "src/**.h",
+        "src/**.cpp"
+    }
+
+    includedirs {
+        "%{wks.location}/SolverCore/src"
+    }
+
+    filter "options:avx2"
+        vectorextensions "AVX2"
+
+    filter "configurations:*Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
+    filter "configurations:*Release"
+        defines { "NDEBUG" }
+        optimize "Speed"
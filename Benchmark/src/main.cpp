@@ -0,0 +1,86 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <string>
+
+#include "overlap.h"
+
+// Layout of the circles before the structure of arrays store
+struct PtrCircle {
+	int index;
+	int typeIndex;
+	double cx, cy, r;
+	PtrCircle(double cx, double cy, double r) : index(0), typeIndex(0), cx(cx), cy(cy), r(r) {}
+};
+
+static bool anyOverlapPointers(const std::vector<std::shared_ptr<PtrCircle>>& circles, double cx, double cy, double r) {
+	for (auto& c : circles) {
+		if ((c->cx - cx) * (c->cx - cx) + (c->cy - cy) * (c->cy - cy) < (r + c->r) * (c->r + r) - 0.0000000001) return true;
+	}
+	return false;
+}
+
+template<typename F>
+static double measure(const std::string& name, int queries, size_t circleCount, F f) {
+	int hits = 0;
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (int q = 0; q < queries; q++) {
+		hits += f(q) ? 1 : 0;
+	}
+	auto endTime = std::chrono::high_resolution_clock::now();
+	double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+	double perCircle = ns / ((double)queries * (double)circleCount);
+	std::cout << name << ": " << ns / 1e6 << "ms (" << perCircle << "ns per circle, " << hits << " hits)" << std::endl;
+	return perCircle;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 1 && argc != 3) {
+		std::cout << "Usage: ./Benchmark [CIRCLES QUERIES]" << std::endl;
+		return 1;
+	}
+	size_t circleCount = 50000;
+	int queries = 2000;
+	if (argc == 3) {
+		circleCount = std::stoul(argv[1]);
+		queries = std::stoi(argv[2]);
+	}
+
+	// small circles scattered over a forest14-sized area, so most queries have to scan every circle
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<double> pos(0., 4000.);
+	std::uniform_real_distribution<double> rad(0.05, 0.5);
+
+	std::vector<std::shared_ptr<PtrCircle>> pointers = std::vector<std::shared_ptr<PtrCircle>>();
+	CircleBlock block;
+	for (size_t i = 0; i < circleCount; i++) {
+		double cx = pos(rng), cy = pos(rng), r = rad(rng);
+		pointers.push_back(std::make_shared<PtrCircle>(cx, cy, r));
+		block.push(cx, cy, r);
+	}
+	std::vector<double> qx, qy, qr;
+	for (int q = 0; q < queries; q++) {
+		qx.push_back(pos(rng));
+		qy.push_back(pos(rng));
+		qr.push_back(rad(rng));
+	}
+
+	std::cout << circleCount << " circles, " << queries << " queries, kernel: " << OVERLAP_KERNEL << std::endl;
+
+	double ptr = measure("shared_ptr loop", queries, circleCount, [&](int q) {
+		return anyOverlapPointers(pointers, qx[q], qy[q], qr[q]);
+	});
+	double scalar = measure("SoA scalar     ", queries, circleCount, [&](int q) {
+		return anyOverlapScalar(block.cx.data(), block.cy.data(), block.r.data(), block.size(), qx[q], qy[q], qr[q]);
+	});
+	double kernel = measure("SoA kernel     ", queries, circleCount, [&](int q) {
+		return anyOverlap(block, qx[q], qy[q], qr[q]);
+	});
+
+	std::cout << "Speedup SoA scalar: " << ptr / scalar << "x" << std::endl;
+	std::cout << "Speedup SoA kernel: " << ptr / kernel << "x" << std::endl;
+
+	return 0;
+}
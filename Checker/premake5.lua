@@ -13,6 +13,10 @@ project "Checker"
         "src/**.txt"
     }
 
+    includedirs {
+        "%{wks.location}/SolverCore/src"
+    }
+
     postbuildcommands {
         '{COPYFILE} "%{cfg.buildtarget.relpath}" "%{wks.location}/results/%{cfg.buildtarget.basename}_%{cfg.buildcfg}%{cfg.buildtarget.extension}"'
     }
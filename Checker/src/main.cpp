@@ -5,6 +5,8 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include "score.h"
+
 struct Circle {
 	double cx, cy, r;
 	int type;
@@ -16,9 +18,8 @@ struct Circle {
 struct CircleType {
 	int index;
 	double radius;
-	int count;
 
-	CircleType(int index, double radius) : index(index), radius(radius), count(0) {}
+	CircleType(int index, double radius) : index(index), radius(radius) {}
 };
 
 int main(int argc, char** argv) {
@@ -67,6 +68,7 @@ int main(int argc, char** argv) {
 	}
 	
 	std::vector<Circle> circles = std::vector<Circle>();
+	Score score(w, h, (int)types.size());
 	{
 		double cx, cy, r;
 		int type;
@@ -79,7 +81,7 @@ int main(int argc, char** argv) {
 			if (types[type].radius != r) {
 				std::cout << "Radius for type! Line: " << lineNum << std::endl;
 			} else {
-				types[type].count++;
+				score.add(type, r);
 			}
 			circles.emplace_back(cx, cy, r, type);
 			lineNum++;
@@ -87,23 +89,9 @@ int main(int argc, char** argv) {
 	}
 	outFile.close();
 
-	double size = 0;
-	double totalCountSquared = 0.;
-	double sumCountsSquared = 0.;
-	for (auto const& type : types) {
-		size += type.count * type.radius * type.radius;
-		totalCountSquared += type.count;
-		sumCountsSquared += (double)type.count * (double)type.count;
-	}
-	totalCountSquared *= totalCountSquared;
-	size *= M_PI;
-
-	double A = size / (w * h);
-	double D = 1. - (double)sumCountsSquared / totalCountSquared;
-
-	std::cout << "A: " << A << std::endl;
-	std::cout << "D: " << D << std::endl;
-	std::cout << "B: " << A * D << std::endl;
+	std::cout << "A: " << score.A() << std::endl;
+	std::cout << "D: " << score.D() << std::endl;
+	std::cout << "B: " << score.B() << std::endl;
 
 	double maxDiff = 0.;
 
@@ -4,6 +4,8 @@
 #include <vector>
 #include <iostream>
 
+#include "score.h"
+
 struct Circle {
 	double cx, cy, r;
 	int type;
@@ -98,30 +100,14 @@ int main(int argc, char** argv) {
 		circles.emplace_back(Circle{ cx, h - cy, r, type });
 	}
 
-	std::vector<long> counts = std::vector<long>();
-	for (int i = 0; i <= maxType; i++) {
-		counts.push_back(0);
-	}
-
-	double size = 0;
+	Score score(w, h, maxType + 1);
 	for (auto& c : circles) {
-		counts[c.type]++;
-		size += c.r * c.r * M_PI;
+		score.add(c.type, c.r);
 	}
 
-	double totalCountSquared = 0.;
-	double sumCountsSquared = 0.;
-	for (int i = 0; i < counts.size(); i++) {
-		totalCountSquared += counts[i];
-		sumCountsSquared += (double)counts[i] * (double)counts[i];
-	}
-
-	double A = size / (w * h);
-	double D = 1. - (double)sumCountsSquared / totalCountSquared / totalCountSquared;
-
-	std::cout << "A: " << A << std::endl;
-	std::cout << "D: " << D << std::endl;
-	std::cout << "B: " << A * D << std::endl;
+	std::cout << "A: " << score.A() << std::endl;
+	std::cout << "D: " << score.D() << std::endl;
+	std::cout << "B: " << score.B() << std::endl;
 
 	// scale down
 	while (w > 900. || h > 900.) {
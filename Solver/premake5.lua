@@ -13,6 +13,14 @@ project "Solver"
         "src/**.txt"
     }
 
+    includedirs {
+        "%{wks.location}/SolverCore/src"
+    }
+
+    links {
+        "SolverCore"
+    }
+
     postbuildcommands {
         '{COPYFILE} "%{cfg.buildtarget.relpath}" "%{wks.location}/inputs/%{cfg.buildtarget.basename}_%{cfg.buildcfg}%{cfg.buildtarget.extension}"',
     }
@@ -40,6 +48,11 @@ project "Solver"
             "SDL2"
         }
 
+    filter "system:linux"
+        links {
+            "pthread"
+        }
+
     filter "configurations:*Debug"
         defines { "DEBUG" }
         symbols "On"
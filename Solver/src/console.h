@@ -0,0 +1,167 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "observer.h"
+
+#ifdef DRAW_SDL
+#include <SDL2/SDL.h>
+#endif
+
+/*
+Prints the progress and statistics of runs
+*/
+class ConsoleObserver : public SolverObserver {
+public:
+	void progress(const Progress& p) override {
+		std::cout << "Max: " << p.maxB << " = " << p.maxA << " * " << p.maxD << " at "
+			<< p.circlesAtMax << " circles; Current: " << p.circles << " circles B=" << p.B << std::endl;
+		if (p.dead >= 0) std::cout << "Dead connections: " << p.dead << " of " << p.open << std::endl;
+	}
+
+	void finished(const Summary& s, const CircleStore& circles) override {
+		const RunStats& stats = s.stats;
+		std::cout << "Result:\n";
+		std::cout << "Stopped: " << s.stopped << " after " << s.placed << " circles" << std::endl;
+		std::cout << "Max: " << s.maxB << " = " << s.maxA << " * " << s.maxD << " (" << s.circlesAtMax << " circles)" << std::endl;
+		std::cout << "Reduced: " << s.B << " = " << s.A << " * " << s.D << " (" << s.circles << " circles)" << std::endl;
+		std::cout << "C: " << s.B * s.typeCount / (s.typeCount - 1) << std::endl;
+		std::cout << "Connections: " << stats.connsCreated << " created, " << stats.connsFiltered << " filtered, " << stats.connsEvaluated << " evaluated ("
+			<< (double)stats.connsEvaluated / std::max(1, s.placed) << " per circle), " << stats.connsUpdated << " updated, "
+			<< stats.connsDropped << " dropped, " << stats.connsRetired << " retired, " << stats.fitsPastGap << " radii fit past the gap" << std::endl;
+		std::cout << "Neighbour caches: " << stats.neighbourHits << " of " << stats.neighbourHits + stats.neighbourMisses << " gap-searches, " << stats.checkHits << " of " << stats.checkHits + stats.checkMisses << " overlap-checks, "
+			<< (double)stats.neighbourSize / std::max(1ll, stats.neighbourHits + stats.checkHits) << " circles on average, "
+			<< stats.neighbourBytes / 1024 << " KiB" << std::endl;
+		if (s.budget > 0) std::cout << "Evaluation budget used up " << stats.budgetExhausted << " times" << std::endl;
+#ifdef DEBUG
+		std::cout << "Duplicate connections: " << stats.connsDuplicate << std::endl;
+#endif
+	}
+
+	void error(const std::string& message) override {
+		std::cout << message << std::endl;
+	}
+};
+
+#ifdef DRAW_SDL
+/*
+Draw the outline of a circle
+*/
+static void drawCircle(SDL_Renderer* renderer, const Circle& c, double scale) {
+	int32_t cx = (int32_t)c.cx;
+	int32_t cy = (int32_t)c.cy;
+	const int32_t diameter = std::max(1, (int32_t)(c.r * 2. * scale));
+
+	int32_t x = (int32_t)c.r - 1;
+	int32_t y = 0;
+	int32_t tx = 1;
+	int32_t ty = 1;
+	int32_t error = tx - diameter;
+
+	while (x >= y) {
+		SDL_RenderDrawPoint(renderer, cx + x, cy - y);
+		SDL_RenderDrawPoint(renderer, cx + x, cy + y);
+		SDL_RenderDrawPoint(renderer, cx - x, cy - y);
+		SDL_RenderDrawPoint(renderer, cx - x, cy + y);
+		SDL_RenderDrawPoint(renderer, cx + y, cy - x);
+		SDL_RenderDrawPoint(renderer, cx + y, cy + x);
+		SDL_RenderDrawPoint(renderer, cx - y, cy - x);
+		SDL_RenderDrawPoint(renderer, cx - y, cy + x);
+
+		if (error <= 0) {
+			y++;
+			error += ty;
+			ty += 2;
+		}
+
+		if (error > 0) {
+			x--;
+			tx += 2;
+			error += tx - diameter;
+		}
+	}
+}
+
+/*
+Prints like the ConsoleObserver and draws the circles after every round in a window.
+After the run the window stays open until it's closed or Escape is pressed.
+*/
+class WindowObserver : public ConsoleObserver {
+public:
+	WindowObserver() : window(NULL), renderer(NULL), scale(1.) {
+		if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+			std::cout << "Failed to initialize SDL! Error: " << SDL_GetError() << std::endl;
+			return;
+		}
+
+		window = SDL_CreateWindow("Circles", 0, 30, 600, 600, NULL);
+		if (window == NULL) {
+			std::cout << "Failed to create SDL_Window! Error: " << SDL_GetError() << std::endl;
+			return;
+		}
+
+		renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+		if (renderer == NULL) {
+			std::cout << "Failed to create SDL_Renderer! Error: " << SDL_GetError() << std::endl;
+			return;
+		}
+	}
+
+	~WindowObserver() {
+		SDL_DestroyRenderer(renderer);
+		SDL_DestroyWindow(window);
+		SDL_Quit();
+	}
+
+	void started(double w, double h) override {
+		if (w > 1000 || h > 1000) {
+			scale = std::max(w, h) / 1000.;
+		} else {
+			scale = 1.;
+		}
+
+		SDL_SetWindowSize(window, (int)w, (int)h);
+		SDL_ShowWindow(window);
+	}
+
+	void round(const CircleStore& circles) override {
+		render(circles);
+	}
+
+	void finished(const Summary& summary, const CircleStore& circles) override {
+		ConsoleObserver::finished(summary, circles);
+
+		bool c = false;
+		while (!c) {
+			SDL_Event e;
+			while (SDL_PollEvent(&e)) {
+				if (e.type == SDL_QUIT) c = true;
+				if (e.type == SDL_KEYUP && e.key.keysym.scancode == SDL_SCANCODE_ESCAPE) c = true;
+			}
+			render(circles);
+		}
+	}
+
+private:
+	/*
+	Render the computed circles
+	*/
+	void render(const CircleStore& circles) {
+		if (renderer == NULL) return;
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0xff);
+		SDL_RenderClear(renderer);
+
+		SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0xff);
+		for (int i = 0; i < (int)circles.size(); i++) {
+			drawCircle(renderer, circles.get(i), scale);
+		}
+
+		SDL_RenderPresent(renderer);
+	}
+
+	SDL_Window* window;
+	SDL_Renderer* renderer;
+	double scale;
+};
+#endif
+
+#endif
@@ -1,6 +1,99 @@
 #include "solver.h"
+#include "sweep.h"
+#include "race.h"
+#include "tune.h"
+#include "console.h"
 
 #include <chrono>
+#include <csignal>
+#include <thread>
+#include <sstream>
+
+/*
+Remove the option with the given prefix from the arguments and store its value; returns false if it isn't given
+*/
+static bool takeOption(std::vector<std::string>& args, const std::string& prefix, std::string& value) {
+	auto it = std::find_if(args.begin(), args.end(), [&](const std::string& s) { return s.substr(0, prefix.size()) == prefix; });
+	if (it == args.end()) return false;
+	value = it->substr(prefix.size());
+	args.erase(it);
+	return true;
+}
+
+/*
+Weightings of "START:END:STEP" (both ends included) or "A,B,C"; false if one of them isn't between 0 and 2
+*/
+static bool parseWeightings(const std::string& s, std::vector<double>& values) {
+	values.clear();
+	size_t colon = s.find(':');
+	if (colon != std::string::npos) {
+		size_t second = s.find(':', colon + 1);
+		double start = std::stod(s.substr(0, colon));
+		double end = std::stod(s.substr(colon + 1, second - colon - 1));
+		double step = second == std::string::npos ? 0. : std::stod(s.substr(second + 1));
+		if (step <= 0.) {
+			values.push_back(start);
+		}
+		for (int i = 0; step > 0. && start + i * step <= end + 1e-9; i++) {
+			values.push_back(start + i * step);
+		}
+	} else {
+		std::stringstream stream(s);
+		std::string value;
+		while (std::getline(stream, value, ',')) {
+			values.push_back(std::stod(value));
+		}
+	}
+	return std::all_of(values.begin(), values.end(), [](double w) { return w >= 0. && w <= 2.; });
+}
+
+/*
+Whether s ends with suffix
+*/
+static bool endsWith(const std::string& s, const std::string& suffix) {
+	return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/*
+Seeds of "FIRST:LAST" (both included) or "A,B,C"
+*/
+static std::vector<unsigned> parseSeeds(const std::string& s) {
+	std::vector<unsigned> values;
+	size_t colon = s.find(':');
+	if (colon != std::string::npos) {
+		unsigned long first = std::stoul(s.substr(0, colon));
+		unsigned long last = std::stoul(s.substr(colon + 1));
+		for (unsigned long seed = first; seed <= last; seed++) {
+			values.push_back((unsigned)seed);
+		}
+		return values;
+	}
+	std::stringstream stream(s);
+	std::string value;
+	while (std::getline(stream, value, ',')) {
+		values.push_back((unsigned)std::stoul(value));
+	}
+	return values;
+}
+
+// set by the first SIGINT/SIGTERM; stops the solver, which still writes the best result
+static std::atomic<bool> interrupted(false);
+
+/*
+The first SIGINT/SIGTERM ends the run and still writes the best result, a second one ends the program
+*/
+static void onSignal(int signal) {
+	interrupted = true;
+	std::signal(signal, SIG_DFL);
+}
+
+/*
+Let SIGINT/SIGTERM stop the solver; only called once all input was read, before that they end the program as usual
+*/
+static void catchSignals() {
+	std::signal(SIGINT, onSignal);
+	std::signal(SIGTERM, onSignal);
+}
 
 int main(int argc, char** argv) {
 	std::string input;
@@ -13,15 +106,181 @@ int main(int argc, char** argv) {
 		args.emplace_back(argv[i]);
 	}
 
-	auto it = std::find_if(args.begin(), args.end(), [](const std::string& s) { return s.substr(0, 6) == "--out="; });
+	takeOption(args, "--out=", output);
+
+	Revalidation revalidation = Revalidation::EAGER;
+	auto it = std::find(args.begin(), args.end(), "--lazy");
 	if (it != args.end()) {
-		output = it->substr(6);
+		revalidation = Revalidation::LAZY;
 		args.erase(it);
 	}
+
+	std::string value;
+	int budget = 0;
+	if (takeOption(args, "--budget=", value)) budget = std::stoi(value);
+
+	double timeLimit = 0.;
+	if (takeOption(args, "--time-limit=", value)) timeLimit = std::stod(value);
+	int maxCircles = 0;
+	if (takeOption(args, "--max-circles=", value)) maxCircles = std::stoi(value);
+	int window = 1000;
+	if (takeOption(args, "--window=", value)) window = std::stoi(value);
+	int patience = 2;
+	if (takeOption(args, "--patience=", value)) patience = std::stoi(value);
+	if (window < 1 || patience < 1) {
+		std::cout << "--window and --patience must be at least 1" << std::endl;
+		return 1;
+	}
+
+	std::string policies = "perfect,interpolated,improvement";
+	takeOption(args, "--policies=", policies);
+	auto run = Solver::registry().find(policies);
+	if (run == Solver::registry().end()) {
+		std::cout << "Unknown policies '" << policies << "', available:" << std::endl;
+		for (auto& [name, f] : Solver::registry()) {
+			std::cout << "  " << name << std::endl;
+		}
+		return 1;
+	}
+
+	bool sweep = false;
+	it = std::find(args.begin(), args.end(), "--sweep");
+	if (it != args.end()) {
+		sweep = true;
+		args.erase(it);
+	}
+	bool tune = false;
+	it = std::find(args.begin(), args.end(), "--tune");
+	if (it != args.end()) {
+		tune = true;
+		args.erase(it);
+	}
+	// the tuner starts with a coarser grid and averages over a few seeds
+	std::string weightings = tune ? "0:2:0.2" : "0:2:0.1", seeds = tune ? "1:4" : "0", jobsFile, recordsFile;
+	takeOption(args, "--weightings=", weightings);
+	takeOption(args, "--seeds=", seeds);
+	takeOption(args, "--jobs=", jobsFile);
+	takeOption(args, "--records=", recordsFile);
+	int threads = (int)std::thread::hardware_concurrency();
+	if (takeOption(args, "--threads=", value)) threads = std::stoi(value);
+	long long raceBudget = 0;
+	if (takeOption(args, "--race=", value)) raceBudget = std::stoll(value);
+	double keep = 0.5;
+	if (takeOption(args, "--keep=", value)) keep = std::stod(value);
+	double tolerance = 0.005;
+	if (takeOption(args, "--tolerance=", value)) tolerance = std::stod(value);
+
+	auto setup = [&](Solver& s) {
+		s.setRevalidation(revalidation);
+		s.setBudget(budget);
+		s.setConvergence(window, patience);
+		s.setLimits(timeLimit, maxCircles);
+		s.setStopFlag(&interrupted);
+	};
+
+	if (sweep || tune) {
+		if (args.size() != 2) {
+			std::cout << "Usage: ./Solver.exe INPUTFILE --sweep [--weightings=START:END:STEP|A,B,..] [--seeds=FIRST:LAST|A,B,..] [--jobs=FILE]"
+				<< " [--threads=N] [--records=FILE.csv|FILE.jsonl] [--out=BESTOUTPUT] [--race=CIRCLES] [--keep=FRACTION] [options of a single run]\n"
+				<< "       ./Solver.exe INPUTFILE --tune [--weightings=GRID] [--seeds=SEEDS] [--tolerance=WIDTH]"
+				<< " [--threads=N] [--records=FILE] [--out=BESTOUTPUT] [options of a single run]" << std::endl;
+			return 1;
+		}
+		Input in;
+		if (!Solver::readInput(args[1], in)) {
+			std::cout << "Failed to read inputfile!" << std::endl;
+			return 2;
+		}
+
+		std::vector<double> grid;
+		if (!parseWeightings(weightings, grid)) {
+			std::cout << "Weightings must be between 0 and 2" << std::endl;
+			return 1;
+		}
+		std::vector<SweepJob> jobs;
+		if (!jobsFile.empty()) {
+			if (!Sweep::parseJobs(jobsFile, jobs)) {
+				std::cout << "Failed to read jobs-file! Every line has to be \"WEIGHTING SEED\" with a weighting between 0 and 2" << std::endl;
+				return 2;
+			}
+		} else {
+			for (double w : grid) {
+				for (unsigned seed : parseSeeds(seeds)) {
+					jobs.push_back(SweepJob{ w, seed });
+				}
+			}
+		}
+
+		if (jobs.empty() && !tune) {
+			std::cout << "No jobs to run" << std::endl;
+			return 1;
+		}
+
+		std::ofstream recordFile;
+		// one object per line isn't a valid .json-file, so JSON is only written as JSON-lines
+		bool json = endsWith(recordsFile, ".jsonl");
+		if (endsWith(recordsFile, ".json")) {
+			std::cout << "Records are written as JSON-lines, use a .jsonl-file" << std::endl;
+			return 1;
+		}
+		if (!recordsFile.empty()) {
+			recordFile.open(recordsFile, std::ios::out);
+			if (!recordFile.is_open()) {
+				std::cout << "Failed to open records-file!" << std::endl;
+				return 4;
+			}
+		}
+
+		catchSignals();
+		auto startTime = std::chrono::steady_clock::now();
+		Sweep sw(in, args[1], run->second);
+		sw.setSetup(setup);
+		sw.setThreads(threads);
+		sw.setRecords(recordsFile.empty() ? &std::cout : &recordFile, json);
+		sw.setOutput(output);
+		sw.setStopFlag(&interrupted);
+		SweepRecord best;
+		size_t runs = jobs.size();
+		if (tune) {
+			std::vector<unsigned> tuneSeeds = parseSeeds(seeds);
+			Tune tuner(sw, tuneSeeds);
+			tuner.setTolerance(tolerance);
+			tuner.setWidth(std::max(1, threads) / (int)std::max((size_t)1, tuneSeeds.size()));
+			tuner.setLog(&std::cerr);
+			tuner.setStopFlag(&interrupted);
+			best = tuner.run(grid);
+			runs = tuner.runs();
+			const TunePoint& point = tuner.result();
+			std::cerr << "Tuned (" << tuner.stopped() << "): weighting " << point.weighting << " with mean B=" << point.mean
+				<< " +- " << point.error << " over " << point.runs << " seeds" << std::endl;
+		} else if (raceBudget > 0) {
+			Race race(sw, setup);
+			race.setBudget(raceBudget);
+			race.setKeep(keep);
+			race.setLog(&std::cerr);
+			race.setStopFlag(&interrupted);
+			best = race.run(jobs);
+			runs = race.runs();
+		} else {
+			best = sw.run(jobs);
+		}
+		std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - startTime;
+
+		std::cerr << runs << " jobs on " << std::min((size_t)std::max(1, threads), std::max((size_t)1, runs)) << " threads in " << seconds.count() << "s" << std::endl;
+		if (best.B < 0.) return 3;
+		std::cerr << "Best: " << best.B << " = " << best.A << " * " << best.D << " (" << best.circles << " circles) with weighting "
+			<< best.job.weighting << " and seed " << best.job.seed << std::endl;
+		if (sw.outputFailures() > 0) {
+			std::cout << "Failed to save output!" << std::endl;
+			return 4;
+		}
+		return 0;
+	}
 	
 	// Process Command line arguments
 	if (args.size() != 1 && args.size() != 4) {
-		std::cout << "Usage: ./Solver.exe [INPUTFILE WEIGHTING SEED] [--out=OUTPUTFILE]" << std::endl;
+		std::cout << "Usage: ./Solver.exe [INPUTFILE WEIGHTING SEED] [--out=OUTPUTFILE] [--lazy] [--budget=N] [--policies=SELECTION,WEIGHTING,STOP]"
+			<< " [--time-limit=SECONDS] [--max-circles=N] [--window=N] [--patience=N]" << std::endl;
 		return 1;
 	}
 	if (args.size() == 1) {
@@ -55,14 +314,28 @@ int main(int argc, char** argv) {
 	}
 
 	// run
-	auto result = s.run(weighting, seed);
+#ifdef DRAW_SDL
+	WindowObserver observer;
+#else
+	ConsoleObserver observer;
+#endif
+	s.setObserver(&observer);
+	setup(s);
+	catchSignals();
+	auto result = (s.*run->second)(weighting, seed);
 	if (result.circleCountAtMax == -1) {
 		std::cout << "An Error occurred during computation!" << std::endl;
 		return 3;
 	}
+	// nothing to write, an existing output-file is kept
+	if (interrupted && result.placed == 0) {
+		std::cout << "Interrupted before the first circle!" << std::endl;
+		return 5;
+	}
 
 	// write result to output-file
 	if (!output.empty()) {
+		std::cout << "Writing to '" << output << "'" << std::endl;
 		if (!s.writeOutput(result, output)) {
 			std::cout << "Failed to save output!" << std::endl;
 			return 4;
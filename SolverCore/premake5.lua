@@ -0,0 +1,24 @@
+project "SolverCore"  
+    kind "StaticLib" 
+    language "C++"
+    cppdialect "C++17"
+    staticruntime "off"
+
+    targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+    
+    files {
+        "src/**.h",
+        "src/**.cpp"
+    }
+
+    filter "options:avx2"
+        vectorextensions "AVX2"
+
+    filter "configurations:*Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
+    filter "configurations:*Release"
+        defines { "NDEBUG" }
+        optimize "Speed"
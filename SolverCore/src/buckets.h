@@ -0,0 +1,236 @@
+#ifndef BUCKETS_H
+#define BUCKETS_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "utils.h"
+#include "fits.h"
+
+/*
+Index of the highest set bit; bits must not be 0
+*/
+static inline int highestBit(uint64_t bits) {
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanReverse64(&i, bits);
+	return (int)i;
+#else
+	return 63 - __builtin_clzll(bits);
+#endif
+}
+
+/*
+Index of the lowest set bit; bits must not be 0
+*/
+static inline int lowestBit(uint64_t bits) {
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward64(&i, bits);
+	return (int)i;
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+/*
+Calculated connections with buckets per radius-index: a connection is in the buckets of every radius that fits at it (see FitSet).
+Within the buckets of a radius there is one bucket per connection-type and the largest radius up to which the radii,
+starting at this one, fit without a gap; a connection where the next larger radius doesn't fit is a perfect fit.
+The key of a bucket grows with that radius-index (so it shrinks with the radius) and shrinks with the type,
+so the best connection for a radius is always in the highest non-empty bucket of the radius.
+A bitmap of the non-empty buckets of every radius finds that bucket without looking at the connections.
+Connections are inserted at a random position of their bucket, which keeps the order of equally good connections random.
+*/
+class ConnectionBuckets {
+public:
+	ConnectionBuckets() : pool(nullptr), fits(nullptr), radiusCount(0), words(0), count(0) {}
+
+	void init(int radiusCount, ConnectionPool& pool, std::vector<FitSet>& fits) {
+		this->pool = &pool;
+		this->fits = &fits;
+		this->radiusCount = radiusCount;
+		words = (radiusCount * TYPES + 63) / 64;
+		buckets = std::vector<std::vector<int>>(radiusCount * radiusCount * TYPES);
+		bits = std::vector<uint64_t>(radiusCount * words, 0);
+		count = 0;
+	}
+
+	/*
+	Remove all connections but keep the memory of the buckets
+	*/
+	void clear() {
+		for (auto& bucket : buckets) {
+			bucket.clear();
+		}
+		std::fill(bits.begin(), bits.end(), 0);
+		count = 0;
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	/*
+	Insert a connection into the buckets of all radii that fit at it; rnd selects its position among the connections of a bucket
+	*/
+	void insert(int conn, unsigned rnd) {
+		const Connection& c = (*pool)[conn];
+		std::vector<Fit>& connFits = (*fits)[conn].fits;
+		int start = -1;
+		for (size_t k = 0; k < connFits.size(); k++) {
+			Fit& fit = connFits[k];
+			// the radii fit without a gap up to the first radius of the run
+			if (k == 0 || connFits[k - 1].radiusIndex != fit.radiusIndex - 1) start = fit.radiusIndex;
+			fit.key = keyOf(start, c.type);
+			auto& bucket = buckets[bucketOf(fit.radiusIndex, fit.key)];
+			bucket.push_back(conn);
+			size_t j = rnd % bucket.size();
+			std::swap(bucket[j], bucket.back());
+			(*fits)[bucket[j]].get(fit.radiusIndex).slot = (int)j;
+			(*fits)[bucket.back()].get(fit.radiusIndex).slot = (int)bucket.size() - 1;
+			uint64_t& word = bits[fit.radiusIndex * words + fit.key / 64];
+			word |= (uint64_t)1 << (fit.key % 64);
+		}
+		count++;
+	}
+
+	/*
+	Remove a connection from the buckets it was inserted into; its fits must not have changed since then
+	*/
+	void remove(int conn) {
+		for (const Fit& fit : (*fits)[conn].fits) {
+			removeAt(fit.radiusIndex, fit.key, fit.slot);
+		}
+		count--;
+	}
+
+	/*
+	Best connection for a circle with the given radius-index: one where the radius fits and the fewest larger radii,
+	corners before walls before circles. Returns -1 if the radius fits nowhere.
+	*/
+	int find(int radiusIndex) const {
+		const uint64_t* radiusBits = &bits[radiusIndex * words];
+		int key = keyOf(radiusIndex, ConnType::CORNER);
+		for (int word = key / 64; word >= 0; word--) {
+			uint64_t w = radiusBits[word];
+			// ignore buckets above the key in the first word
+			if (word == key / 64 && key % 64 != 63) w &= ((uint64_t)1 << (key % 64 + 1)) - 1;
+			if (w != 0) return buckets[bucketOf(radiusIndex, word * 64 + highestBit(w))].back();
+		}
+		return -1;
+	}
+
+	template<typename F>
+	void forEach(F f) const {
+		// every connection is in the buckets of its largest radius, where no larger radius fits
+		for (int radiusIndex = 0; radiusIndex < radiusCount; radiusIndex++) {
+			for (int type = 0; type < TYPES; type++) {
+				for (int conn : buckets[bucketOf(radiusIndex, keyOf(radiusIndex, (ConnType)type))]) {
+					if ((*fits)[conn].fits[0].radiusIndex == radiusIndex) f(conn);
+				}
+			}
+		}
+	}
+
+private:
+	static constexpr int TYPES = 3;
+
+	static int keyOf(int radiusIndex, ConnType type) {
+		return radiusIndex * TYPES + (TYPES - 1 - (int)type);
+	}
+
+	int bucketOf(int radiusIndex, int key) const {
+		return radiusIndex * radiusCount * TYPES + key;
+	}
+
+	void removeAt(int radiusIndex, int key, int i) {
+		auto& bucket = buckets[bucketOf(radiusIndex, key)];
+		if (i != (int)bucket.size() - 1) {
+			bucket[i] = bucket.back();
+			(*fits)[bucket[i]].get(radiusIndex).slot = i;
+		}
+		bucket.pop_back();
+		if (bucket.empty()) bits[radiusIndex * words + key / 64] &= ~((uint64_t)1 << (key % 64));
+	}
+
+	ConnectionPool* pool;
+	std::vector<FitSet>* fits;
+	int radiusCount;
+	// words of the bitmap of every radius
+	int words;
+	std::vector<std::vector<int>> buckets;
+	std::vector<uint64_t> bits;
+	size_t count;
+};
+
+/*
+Connections that were not calculated yet, ordered by priority: the connections of the newest circle come first,
+because they are close to where the last circle was placed, and within the connections of one circle corners come before
+walls before circles, just like in the buckets. Connections of the same circle and type come in reverse insertion order.
+The queue is a stack with the highest priority at the back.
+*/
+class ConnectionQueue {
+public:
+	ConnectionQueue() : pool(nullptr) {}
+
+	void init(ConnectionPool& pool) {
+		this->pool = &pool;
+	}
+
+	/*
+	Remove all connections but keep the memory
+	*/
+	void clear() {
+		conns.clear();
+	}
+
+	size_t size() const {
+		return conns.size();
+	}
+
+	bool empty() const {
+		return conns.empty();
+	}
+
+	void push(int conn) {
+		const Connection& c = (*pool)[conn];
+		conns.push_back(conn);
+		// move behind the connections of the same circle with a better type
+		for (size_t i = conns.size() - 1; i > 0; i--) {
+			const Connection& prev = (*pool)[conns[i - 1]];
+			if (prev.c1 != c.c1 || prev.type >= c.type) break;
+			std::swap(conns[i - 1], conns[i]);
+		}
+	}
+
+	/*
+	Remove and return the most promising connection; the queue must not be empty
+	*/
+	int pop() {
+		int conn = conns.back();
+		conns.pop_back();
+		return conn;
+	}
+
+	template<typename F>
+	void forEach(F f) const {
+		for (int conn : conns) {
+			f(conn);
+		}
+	}
+
+private:
+	ConnectionPool* pool;
+	std::vector<int> conns;
+};
+
+#endif
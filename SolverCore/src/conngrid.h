@@ -0,0 +1,129 @@
+#ifndef CONNGRID_H
+#define CONNGRID_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "utils.h"
+
+/*
+Spatial index over connections. Every connection is stored with the square around its anchor in which a newly placed
+circle could invalidate it (the half-size does not include the radius of the placed circle).
+Like the circle-grid, there is one level per size-band (each band halves the size), so small connections are stored in small cells.
+*/
+class ConnectionGrid {
+public:
+	ConnectionGrid() : pool(nullptr), maxExtent(0.) {}
+
+	void init(double w, double h, double maxExtent, double minExtent, ConnectionPool& pool) {
+		this->pool = &pool;
+		this->maxExtent = maxExtent;
+		int count = std::clamp((int)std::floor(std::log2(maxExtent / minExtent)) + 1, 1, MAX_LEVELS);
+		levels = std::vector<Level>(count);
+		int offset = 0;
+		for (int i = 0; i < count; i++) {
+			Level& level = levels[i];
+			level.reach = std::ldexp(maxExtent, -i);
+			level.cellSize = std::max(2. * level.reach, std::sqrt(w * h / (double)MAX_CELLS));
+			level.cols = std::max(1, (int)std::ceil(w / level.cellSize));
+			level.rows = std::max(1, (int)std::ceil(h / level.cellSize));
+			level.offset = offset;
+			offset += level.cols * level.rows;
+		}
+		cells = std::vector<std::vector<Entry>>(offset);
+	}
+
+	/*
+	Remove all connections but keep the memory of the cells
+	*/
+	void clear() {
+		for (auto& cell : cells) {
+			cell.clear();
+		}
+		for (int i = 0; i < (int)levels.size(); i++) {
+			levels[i].reach = std::ldexp(maxExtent, -i);
+		}
+	}
+
+	/*
+	Insert a connection whose influence is the square with center (x, y) and half-size extent
+	*/
+	void insert(int conn, double x, double y, double extent) {
+		int l = std::clamp((int)std::floor(std::log2(maxExtent / extent)), 0, (int)levels.size() - 1);
+		Level& level = levels[l];
+		// connections larger than the first band make its queries reach further
+		level.reach = std::max(level.reach, extent);
+		int cell = level.offset + level.row(y) * level.cols + level.col(x);
+		(*pool)[conn].gridCell = cell;
+		(*pool)[conn].gridSlot = (int)cells[cell].size();
+		cells[cell].push_back(Entry{x, y, extent, conn});
+	}
+
+	void remove(int conn) {
+		Connection& c = (*pool)[conn];
+		auto& cell = cells[c.gridCell];
+		int i = c.gridSlot;
+		if (i != (int)cell.size() - 1) {
+			cell[i] = cell.back();
+			(*pool)[cell[i].conn].gridSlot = i;
+		}
+		cell.pop_back();
+		c.gridCell = -1;
+		c.gridSlot = -1;
+	}
+
+	/*
+	Calls f(conn) for every connection whose influence-square, grown by r, contains (x, y).
+	The connections must not be removed while iterating.
+	*/
+	template<typename F>
+	void forEachNear(double x, double y, double r, F f) const {
+		for (const Level& level : levels) {
+			double reach = r + level.reach;
+			int x0 = level.col(x - reach), x1 = level.col(x + reach);
+			int y0 = level.row(y - reach), y1 = level.row(y + reach);
+			for (int row = y0; row <= y1; row++) {
+				for (int col = x0; col <= x1; col++) {
+					for (const Entry& e : cells[level.offset + row * level.cols + col]) {
+						double d = e.extent + r + RADIUS_EPSILON;
+						if (std::abs(e.x - x) > d || std::abs(e.y - y) > d) continue;
+						f(e.conn);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	// cells per level, keeps the grid small for inputs with tiny radii on a large area
+	static constexpr int MAX_CELLS = 1 << 18;
+	static constexpr int MAX_LEVELS = 10;
+
+	struct Entry {
+		double x, y, extent;
+		int conn;
+	};
+
+	struct Level {
+		double reach = 0.;
+		double cellSize = 1.;
+		int cols = 0, rows = 0;
+		int offset = 0;
+
+		int col(double x) const {
+			return std::clamp((int)std::floor(x / cellSize), 0, cols - 1);
+		}
+
+		int row(double y) const {
+			return std::clamp((int)std::floor(y / cellSize), 0, rows - 1);
+		}
+	};
+
+	ConnectionPool* pool;
+	double maxExtent;
+	std::vector<Level> levels;
+	std::vector<std::vector<Entry>> cells;
+};
+
+#endif
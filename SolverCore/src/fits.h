@@ -0,0 +1,110 @@
+#ifndef FITS_H
+#define FITS_H
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+#include "utils.h"
+
+/*
+A radius that fits at a connection: the center of its circle and the bucket and position of the connection
+in the buckets of the radius (see ConnectionBuckets)
+*/
+struct Fit {
+	int radiusIndex;
+	Point center;
+	int key = -1;
+	int slot = -1;
+};
+
+/*
+The radii that fit at a connection. A smaller radius can be blocked while a larger one fits, e.g. if a small circle sits deep
+in the cusp of two large ones and the larger circle is placed further out, so every radius is kept on its own:
+bit i is set if the circle with radius-index i doesn't overlap anything.
+Circles are never removed, so a radius only stops fitting when a new circle overlaps its circle; that is tested against the
+centers, which are calculated once.
+*/
+struct FitSet {
+	std::vector<uint64_t> bits;
+	// one per set bit, the largest radius first
+	std::vector<Fit> fits;
+	// bounding box of the circles of all fits; a circle outside of it grown by its radius can't block any of them
+	std::array<double, 4> area;
+	bool known = false;
+
+	/*
+	Remove all fits but keep the memory
+	*/
+	void reset(int radiusCount) {
+		bits.assign((radiusCount + 63) / 64, 0);
+		fits.clear();
+		known = false;
+	}
+
+	bool empty() const {
+		return fits.empty();
+	}
+
+	bool has(int radiusIndex) const {
+		return (bits[radiusIndex / 64] >> (radiusIndex % 64)) & 1;
+	}
+
+	/*
+	Add a fit; radius-indices have to be added in ascending order
+	*/
+	void add(int radiusIndex, const Point& center) {
+		bits[radiusIndex / 64] |= (uint64_t)1 << (radiusIndex % 64);
+		fits.push_back(Fit{ radiusIndex, center });
+	}
+
+	/*
+	Fit of a radius-index whose bit is set
+	*/
+	Fit& get(int radiusIndex) {
+		return *std::lower_bound(fits.begin(), fits.end(), radiusIndex, [](const Fit& f, int i) { return f.radiusIndex < i; });
+	}
+
+	/*
+	Remove the fits for which blocked(fit) is true; returns how many were removed
+	*/
+	template<typename F>
+	int removeIf(F blocked) {
+		size_t kept = 0;
+		for (size_t k = 0; k < fits.size(); k++) {
+			if (blocked(fits[k])) {
+				bits[fits[k].radiusIndex / 64] &= ~((uint64_t)1 << (fits[k].radiusIndex % 64));
+				continue;
+			}
+			fits[kept++] = fits[k];
+		}
+		int removed = (int)(fits.size() - kept);
+		fits.resize(kept);
+		return removed;
+	}
+
+	/*
+	Set the area to the bounding box of the circles of all fits
+	*/
+	void updateArea(const std::vector<double>& radii) {
+		area = std::array<double, 4>{
+			std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+			-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()
+		};
+		for (const Fit& f : fits) {
+			double r = radii[f.radiusIndex];
+			area[0] = std::min(area[0], f.center.x - r);
+			area[1] = std::min(area[1], f.center.y - r);
+			area[2] = std::max(area[2], f.center.x + r);
+			area[3] = std::max(area[3], f.center.y + r);
+		}
+	}
+
+	bool contains(double cx, double cy, double r) const {
+		return cx >= area[0] - r && cx <= area[2] + r && cy >= area[1] - r && cy <= area[3] + r;
+	}
+};
+
+#endif
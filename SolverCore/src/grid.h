@@ -0,0 +1,205 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "overlap.h"
+
+/*
+Circles of one grid-cell together with their index in the CircleStore
+*/
+struct GridCell : CircleBlock {
+	std::vector<int> index;
+
+	void push(double x, double y, double radius, int i) {
+		CircleBlock::push(x, y, radius);
+		index.push_back(i);
+	}
+
+	void clear() {
+		CircleBlock::clear();
+		index.clear();
+	}
+};
+
+/*
+Uniform grid over the placement area. Every cell stores the circles whose center lies in it.
+A cell is at least as wide as the largest circle, so collision-queries only have to look at a few cells.
+*/
+class UniformGrid {
+public:
+	UniformGrid() : cols(0), rows(0), cellSize(1.), maxR(0.), count(0) {}
+
+	void init(double w, double h, double maxRadius) {
+		maxR = maxRadius;
+		cellSize = std::max(2. * maxRadius, std::sqrt(w * h / (double)MAX_CELLS));
+		cols = std::max(1, (int)std::ceil(w / cellSize));
+		rows = std::max(1, (int)std::ceil(h / cellSize));
+		cells = std::vector<GridCell>(cols * rows);
+		count = 0;
+	}
+
+	void clear() {
+		for (auto& cell : cells) {
+			cell.clear();
+		}
+		count = 0;
+	}
+
+	void insert(double cx, double cy, double r, int index) {
+		cells[cellIndex(cx, cy)].push(cx, cy, r, index);
+		count++;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	/*
+	Check if a circle at (cx, cy) with radius r overlaps any inserted circle
+	*/
+	bool anyOverlap(double cx, double cy, double r) const {
+		double reach = r + maxR;
+		int x0 = clampCol(cx - reach), x1 = clampCol(cx + reach);
+		int y0 = clampRow(cy - reach), y1 = clampRow(cy + reach);
+		for (int y = y0; y <= y1; y++) {
+			for (int x = x0; x <= x1; x++) {
+				if (::anyOverlap(cells[y * cols + x], cx, cy, r)) return true;
+			}
+		}
+		return false;
+	}
+
+	/*
+	Index of an inserted circle that overlaps a circle at (cx, cy) with radius r, -1 if there is none
+	*/
+	int findOverlap(double cx, double cy, double r) const {
+		double reach = r + maxR;
+		int x0 = clampCol(cx - reach), x1 = clampCol(cx + reach);
+		int y0 = clampRow(cy - reach), y1 = clampRow(cy + reach);
+		for (int y = y0; y <= y1; y++) {
+			for (int x = x0; x <= x1; x++) {
+				const GridCell& cell = cells[y * cols + x];
+				for (size_t i = 0; i < cell.size(); i++) {
+					if (anyOverlapScalar(&cell.cx[i], &cell.cy[i], &cell.r[i], 1, cx, cy, r)) return cell.index[i];
+				}
+			}
+		}
+		return -1;
+	}
+
+	/*
+	Calls f(cx, cy, r, index) for every circle that could collide with a circle inside the rectangle (x0, y0) - (x1, y1) with radius up to r
+	*/
+	template<typename F>
+	void forEachNear(double x0, double y0, double x1, double y1, double r, F f) const {
+		double reach = r + maxR;
+		int cx0 = clampCol(x0 - reach), cx1 = clampCol(x1 + reach);
+		int cy0 = clampRow(y0 - reach), cy1 = clampRow(y1 + reach);
+		for (int y = cy0; y <= cy1; y++) {
+			for (int x = cx0; x <= cx1; x++) {
+				const GridCell& cell = cells[y * cols + x];
+				for (size_t i = 0; i < cell.size(); i++) {
+					// skip circles that are too far away for their own radius
+					double d = r + cell.r[i];
+					if (cell.cx[i] < x0 - d || cell.cx[i] > x1 + d || cell.cy[i] < y0 - d || cell.cy[i] > y1 + d) continue;
+					f(cell.cx[i], cell.cy[i], cell.r[i], cell.index[i]);
+				}
+			}
+		}
+	}
+
+private:
+	// keep the grid small for inputs with tiny radii on a large area
+	static constexpr int MAX_CELLS = 1 << 20;
+
+	int clampCol(double x) const {
+		return std::clamp((int)std::floor(x / cellSize), 0, cols - 1);
+	}
+
+	int clampRow(double y) const {
+		return std::clamp((int)std::floor(y / cellSize), 0, rows - 1);
+	}
+
+	int cellIndex(double cx, double cy) const {
+		return clampRow(cy) * cols + clampCol(cx);
+	}
+
+	int cols, rows;
+	double cellSize;
+	double maxR;
+	size_t count;
+	std::vector<GridCell> cells;
+};
+
+/*
+One uniform grid per radius-band (each band halves the radius), so small circles don't have to be searched
+in cells sized for the largest circle. Everything below the last band shares its grid, so large
+gap-searches don't have to walk over lots of tiny cells.
+*/
+class Grid {
+public:
+	Grid() : maxR(0.) {}
+
+	void init(double w, double h, double maxRadius, double minRadius) {
+		maxR = maxRadius;
+		int count = std::clamp((int)std::floor(std::log2(maxRadius / minRadius)) + 1, 1, MAX_LEVELS);
+		levels = std::vector<UniformGrid>(count);
+		for (int i = 0; i < count; i++) {
+			levels[i].init(w, h, std::ldexp(maxRadius, -i));
+		}
+	}
+
+	void clear() {
+		for (auto& level : levels) {
+			level.clear();
+		}
+	}
+
+	void insert(double cx, double cy, double r, int index) {
+		int level = std::clamp((int)std::floor(std::log2(maxR / r)), 0, (int)levels.size() - 1);
+		levels[level].insert(cx, cy, r, index);
+	}
+
+	/*
+	Check if a circle at (cx, cy) with radius r overlaps any inserted circle
+	*/
+	bool anyOverlap(double cx, double cy, double r) const {
+		for (auto& level : levels) {
+			if (!level.empty() && level.anyOverlap(cx, cy, r)) return true;
+		}
+		return false;
+	}
+
+	/*
+	Index of an inserted circle that overlaps a circle at (cx, cy) with radius r, -1 if there is none
+	*/
+	int findOverlap(double cx, double cy, double r) const {
+		for (auto& level : levels) {
+			if (level.empty()) continue;
+			int i = level.findOverlap(cx, cy, r);
+			if (i != -1) return i;
+		}
+		return -1;
+	}
+
+	/*
+	Calls f(cx, cy, r, index) for every circle that could collide with a circle inside the rectangle (x0, y0) - (x1, y1) with radius up to r
+	*/
+	template<typename F>
+	void forEachNear(double x0, double y0, double x1, double y1, double r, F f) const {
+		for (auto& level : levels) {
+			if (!level.empty()) level.forEachNear(x0, y0, x1, y1, r, f);
+		}
+	}
+
+private:
+	static constexpr int MAX_LEVELS = 4;
+
+	double maxR;
+	std::vector<UniformGrid> levels;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef NEIGHBOURS_H
+#define NEIGHBOURS_H
+
+#include <array>
+
+// circles a connection remembers at most; connections with more neighbours search the grid every time
+#define NEIGHBOUR_CACHE_SIZE 32
+
+/*
+The circles that could block the gap of a connection: every circle that could touch a circle placed at the connection
+with a radius up to reach. It is collected by the first gap-search; lazy connections add newly placed circles while they live,
+so they can be calculated again without the grid.
+*/
+struct NeighbourCache {
+	bool known = false;
+	int count = 0;
+	double reach = 0.;
+	// circles with their center outside of this area grown by their radius can't be neighbours
+	std::array<double, 4> area;
+	std::array<int, NEIGHBOUR_CACHE_SIZE> circles;
+
+	void reset() {
+		known = false;
+		count = 0;
+	}
+
+	bool contains(double cx, double cy, double r) const {
+		return cx >= area[0] - r && cx <= area[2] + r && cy >= area[1] - r && cy <= area[3] + r;
+	}
+
+	/*
+	Add a circle; returns false and forgets all circles if the cache is full
+	*/
+	bool add(int circle) {
+		if (count == NEIGHBOUR_CACHE_SIZE) {
+			reset();
+			return false;
+		}
+		circles[count++] = circle;
+		return true;
+	}
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef OBSERVER_H
+#define OBSERVER_H
+
+#include "utils.h"
+
+/*
+Statistics about the connections of a run
+*/
+struct RunStats {
+	int connsCreated = 0;
+	// created connections that were dropped right away, because the smallest circle doesn't fit
+	int connsFiltered = 0;
+	int connsEvaluated = 0;
+	// radii that fit past the first touch of their connection
+	int fitsPastGap = 0;
+	// connections where a new circle blocked radii
+	int connsUpdated = 0;
+	int connsDropped = 0;
+	int connsRetired = 0;
+	// circles for which the evaluation budget was used up
+	int budgetExhausted = 0;
+	// gap-searches that could use the neighbours of their connection
+	int neighbourHits = 0;
+	int neighbourMisses = 0;
+	// overlap-checks of a single circle that could use the neighbours of their connection instead of the grid
+	long long checkHits = 0;
+	long long checkMisses = 0;
+	// circles tested from the neighbours by the gap-searches and overlap-checks that used them
+	long long neighbourSize = 0;
+	size_t neighbourBytes = 0;
+	// every connection is created only once; only counted in debug-builds
+	int connsDuplicate = 0;
+};
+
+/*
+State of a run after every window of circles
+*/
+struct Progress {
+	double maxA, maxD, maxB;
+	int circlesAtMax;
+	int circles;
+	double B;
+	// connections that can't fit any circle anymore and all open ones; only counted in debug-builds, -1 otherwise
+	int dead = -1;
+	int open = 0;
+};
+
+/*
+End of a run: why it stopped, the maximum while placing and the result after reducing it
+*/
+struct Summary {
+	StopReason stopped;
+	int placed;
+	double maxA, maxD, maxB;
+	int circlesAtMax;
+	double A, D, B;
+	int circles;
+	int typeCount;
+	int budget;
+	RunStats stats;
+};
+
+/*
+Gets told what a Solver does, instead of the Solver printing or drawing it itself.
+All methods are called from the thread of the run and do nothing by default.
+*/
+class SolverObserver {
+public:
+	virtual ~SolverObserver() {}
+
+	// a run on a rectangle of w * h starts
+	virtual void started(double w, double h) {}
+	// every radius-class had its turn; circles are all placed so far
+	virtual void round(const CircleStore& circles) {}
+	virtual void progress(const Progress& progress) {}
+	virtual void finished(const Summary& summary, const CircleStore& circles) {}
+	// the run couldn't start
+	virtual void error(const std::string& message) {}
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef OVERLAP_H
+#define OVERLAP_H
+
+#include <cstddef>
+#include <vector>
+#if !defined(OVERLAP_SCALAR) && (defined(__AVX__) || defined(__SSE2__) || defined(_M_X64))
+#include <immintrin.h>
+#endif
+
+#define OVERLAP_EPSILON 0.0000000001
+
+/*
+Circles stored as structure of arrays, so the overlap-test can load several circles at once
+*/
+struct CircleBlock {
+	std::vector<double> cx, cy, r;
+
+	void push(double x, double y, double radius) {
+		cx.push_back(x);
+		cy.push_back(y);
+		r.push_back(radius);
+	}
+
+	void clear() {
+		cx.clear();
+		cy.clear();
+		r.clear();
+	}
+
+	size_t size() const {
+		return cx.size();
+	}
+};
+
+/*
+Check if a circle at (x, y) with radius rad overlaps one of the first n circles of the arrays.
+Every implementation calculates exactly the same terms as the scalar one, so results don't depend on the instruction set.
+The instruction set is chosen at build time; define OVERLAP_SCALAR to force the scalar loop.
+*/
+static inline bool anyOverlapScalar(const double* cx, const double* cy, const double* r, size_t n, double x, double y, double rad) {
+	for (size_t i = 0; i < n; i++) {
+		double dx = cx[i] - x;
+		double dy = cy[i] - y;
+		if (dx * dx + dy * dy < (rad + r[i]) * (rad + r[i]) - OVERLAP_EPSILON) return true;
+	}
+	return false;
+}
+
+#if !defined(OVERLAP_SCALAR) && defined(__AVX__)
+#define OVERLAP_KERNEL "AVX"
+static inline bool anyOverlap(const double* cx, const double* cy, const double* r, size_t n, double x, double y, double rad) {
+	const __m256d vx = _mm256_set1_pd(x);
+	const __m256d vy = _mm256_set1_pd(y);
+	const __m256d vr = _mm256_set1_pd(rad);
+	const __m256d eps = _mm256_set1_pd(OVERLAP_EPSILON);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(cx + i), vx);
+		__m256d dy = _mm256_sub_pd(_mm256_loadu_pd(cy + i), vy);
+		__m256d rs = _mm256_add_pd(vr, _mm256_loadu_pd(r + i));
+		__m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+		__m256d lim = _mm256_sub_pd(_mm256_mul_pd(rs, rs), eps);
+		if (_mm256_movemask_pd(_mm256_cmp_pd(d2, lim, _CMP_LT_OQ))) return true;
+	}
+	return anyOverlapScalar(cx + i, cy + i, r + i, n - i, x, y, rad);
+}
+#elif !defined(OVERLAP_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+#define OVERLAP_KERNEL "SSE2"
+static inline bool anyOverlap(const double* cx, const double* cy, const double* r, size_t n, double x, double y, double rad) {
+	const __m128d vx = _mm_set1_pd(x);
+	const __m128d vy = _mm_set1_pd(y);
+	const __m128d vr = _mm_set1_pd(rad);
+	const __m128d eps = _mm_set1_pd(OVERLAP_EPSILON);
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128d dx = _mm_sub_pd(_mm_loadu_pd(cx + i), vx);
+		__m128d dy = _mm_sub_pd(_mm_loadu_pd(cy + i), vy);
+		__m128d rs = _mm_add_pd(vr, _mm_loadu_pd(r + i));
+		__m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+		__m128d lim = _mm_sub_pd(_mm_mul_pd(rs, rs), eps);
+		if (_mm_movemask_pd(_mm_cmplt_pd(d2, lim))) return true;
+	}
+	return anyOverlapScalar(cx + i, cy + i, r + i, n - i, x, y, rad);
+}
+#else
+#define OVERLAP_KERNEL "scalar"
+static inline bool anyOverlap(const double* cx, const double* cy, const double* r, size_t n, double x, double y, double rad) {
+	return anyOverlapScalar(cx, cy, r, n, x, y, rad);
+}
+#endif
+
+static inline bool anyOverlap(const CircleBlock& block, double x, double y, double rad) {
+	return anyOverlap(block.cx.data(), block.cy.data(), block.r.data(), block.size(), x, y, rad);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef POLICIES_H
+#define POLICIES_H
+
+#include <cmath>
+
+/*
+Policies of the solver. Solver::runWith is instantiated for every combination (see Solver::registry),
+so a policy costs nothing in the loop that places the circles.
+*/
+
+/*
+Selection: which connection a circle is placed at
+*/
+
+// calculate unknown connections only until one fits the radius perfectly
+struct PerfectFitSelection {
+	static constexpr const char* name = "perfect";
+	static constexpr bool stopAtPerfectFit = true;
+};
+
+// calculate all unknown connections, then take the best one
+struct ExhaustiveSelection {
+	static constexpr const char* name = "exhaustive";
+	static constexpr bool stopAtPerfectFit = false;
+};
+
+/*
+Weighting: how often a circle-type is placed compared to the others, relative to its radius r.
+The weighting parameter is between 0 and 2.
+*/
+
+// interpolate somewhat smoothly between 1, r, r^2
+struct InterpolatedWeighting {
+	static constexpr const char* name = "interpolated";
+
+	static double weight(double r, double weighting) {
+		if (weighting <= 1.) return (weighting * weighting * r) + (1. - weighting * weighting);
+		return r * (std::pow(weighting - 1., 5.) * r + (1. - std::pow(weighting - 1., 5.)));
+	}
+};
+
+// r^weighting
+struct PowerWeighting {
+	static constexpr const char* name = "power";
+
+	static double weight(double r, double weighting) {
+		return std::pow(r, weighting);
+	}
+};
+
+/*
+Stop: when to end a run. Checked every window circles with the number of those checks without a new maximum in a row
+and the patience of the run (see Solver::setConvergence).
+A run always ends when no connection is left or a limit of the run is reached (see Solver::setLimits).
+*/
+
+// no new maximum for patience checks
+struct NoImprovementStop {
+	static constexpr const char* name = "improvement";
+
+	static bool done(int sameFor, int patience) {
+		return sameFor >= patience;
+	}
+};
+
+// place circles until nothing fits anymore
+struct ExhaustedStop {
+	static constexpr const char* name = "exhausted";
+
+	static bool done(int, int) {
+		return false;
+	}
+};
+
+#endif
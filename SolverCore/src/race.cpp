@@ -0,0 +1,116 @@
+#include "race.h"
+
+#include <cmath>
+
+Race::Race(Sweep& sweep, std::function<void(Solver&)> setup)
+	: sweep(sweep), setup(setup), budget(0), keep(0.5), log(nullptr), stopFlag(nullptr), runCount(0) {
+}
+
+void Race::setBudget(long long circles) {
+	budget = circles;
+}
+
+/*
+Part of the candidates kept after every round, between 0 and 1; at least one is dropped per round
+*/
+void Race::setKeep(double fraction) {
+	keep = std::clamp(fraction, 0.01, 0.99);
+}
+
+void Race::setLog(std::ostream* log) {
+	this->log = log;
+}
+
+/*
+Ends the race as soon as it's set, after the running jobs returned their best circles so far
+*/
+void Race::setStopFlag(const std::atomic<bool>* flag) {
+	stopFlag = flag;
+	sweep.setStopFlag(flag);
+}
+
+/*
+Race the candidates and return the best record of all rounds (B is -1 if there was none).
+The circle-limit of the setup is replaced by the budget of the round and there is no time-limit.
+*/
+SweepRecord Race::run(const std::vector<SweepJob>& candidates) {
+	runCount = 0;
+	if (candidates.empty()) return SweepRecord();
+
+	std::vector<Candidate> ranked;
+	for (auto& job : candidates) {
+		ranked.push_back(Candidate{ job, SweepRecord(), false });
+	}
+
+	// candidates in every round, until one is left
+	std::vector<size_t> sizes = { ranked.size() };
+	while (sizes.back() > 1) {
+		size_t n = sizes.back();
+		sizes.push_back(std::min(n - 1, (size_t)std::ceil((double)n * keep)));
+	}
+
+	SweepRecord best;
+	for (size_t round = 0; round < sizes.size(); round++) {
+		size_t n = sizes[round];
+		int circles = (int)std::max(1ll, budget / (long long)(sizes.size() * n));
+
+		std::vector<SweepJob> jobs;
+		std::vector<size_t> running;
+		for (size_t i = 0; i < n; i++) {
+			if (ranked[i].done) continue;
+			jobs.push_back(ranked[i].job);
+			running.push_back(i);
+		}
+
+		auto roundSetup = setup;
+		sweep.setSetup([roundSetup, circles](Solver& s) {
+			if (roundSetup) roundSetup(s);
+			s.setLimits(0., circles);
+		});
+		best = sweep.run(jobs);
+		runCount += (int)jobs.size();
+
+		const std::vector<SweepRecord>& results = sweep.lastResults();
+		for (size_t j = 0; j < running.size(); j++) {
+			// an interrupted run is cut short, the result of the last round says more
+			if (results[j].B < 0. || results[j].stopped == StopReason::INTERRUPTED) continue;
+			Candidate& c = ranked[running[j]];
+			c.record = results[j];
+			c.done = c.record.stopped != StopReason::CIRCLE_LIMIT;
+		}
+		bool stopped = stopFlag && stopFlag->load();
+
+		std::stable_sort(ranked.begin(), ranked.begin() + n, [](const Candidate& lhs, const Candidate& rhs) {
+			return lhs.record.B > rhs.record.B;
+		});
+		size_t kept = round + 1 < sizes.size() && !stopped ? sizes[round + 1] : n;
+		leaderboard((int)round + 1, circles, ranked, n, kept);
+		if (stopped) break;
+
+		// the rounds left would only run candidates that are done already
+		bool open = false;
+		for (size_t i = 0; i < kept; i++) {
+			open = open || !ranked[i].done;
+		}
+		if (!open) break;
+	}
+	return best;
+}
+
+/*
+Log the n candidates of a round by their B, the kept ones that go on first
+*/
+void Race::leaderboard(int round, int circles, const std::vector<Candidate>& ranked, size_t n, size_t kept) {
+	if (!log) return;
+	*log << "Round " << round << ": " << n << " candidates, up to " << circles << " circles each" << std::endl;
+	for (size_t i = 0; i < n; i++) {
+		if (i == kept) *log << "  ---" << std::endl;
+		const Candidate& c = ranked[i];
+		*log << "  " << i + 1 << ". B=" << c.record.B << " weighting " << c.job.weighting << " seed " << c.job.seed
+			<< " (" << c.record.placed << " circles, " << c.record.stopped << ")" << std::endl;
+	}
+}
+
+int Race::runs() const {
+	return runCount;
+}
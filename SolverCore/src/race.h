@@ -0,0 +1,50 @@
+#ifndef RACE_H
+#define RACE_H
+
+#include "sweep.h"
+
+/*
+Successive halving on top of a Sweep: all candidates get a few circles, the better part of them gets more circles in the next round
+and so on, until one is left. Every round gets the same share of the total budget of circles, split evenly over the
+candidates that are still in the race, so the circles concentrate on the promising candidates.
+Runs are deterministic, so a candidate runs again from the start with its larger budget instead of being kept in memory;
+the first circles of the longer run are the same. That replays the circles of its last round, which count towards the budget:
+with keep = 0.5 about half of the circles of a round are new. Candidates that stop by themselves before their budget
+are done and keep their result.
+*/
+class Race {
+public:
+	Race(Sweep& sweep, std::function<void(Solver&)> setup);
+
+	// circles of all candidates in all rounds together
+	void setBudget(long long circles);
+	// part of the candidates that goes on to the next round
+	void setKeep(double fraction);
+	// leaderboard of every round, none if null
+	void setLog(std::ostream* log);
+	void setStopFlag(const std::atomic<bool>* flag);
+
+	SweepRecord run(const std::vector<SweepJob>& candidates);
+
+	// runs started by the last race in all rounds
+	int runs() const;
+
+private:
+	struct Candidate {
+		SweepJob job;
+		SweepRecord record;
+		bool done;
+	};
+
+	void leaderboard(int round, int circles, const std::vector<Candidate>& ranked, size_t n, size_t kept);
+
+	Sweep& sweep;
+	std::function<void(Solver&)> setup;
+	long long budget;
+	double keep;
+	std::ostream* log;
+	const std::atomic<bool>* stopFlag;
+	int runCount;
+};
+
+#endif
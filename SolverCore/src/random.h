@@ -0,0 +1,40 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/*
+Counter-based random numbers: the number for a counter only depends on the seed and the counter, not on the numbers
+drawn before. So whoever knows the seed and e.g. the ordinal of a circle gets the same number, in any order and on any thread.
+Every number is the SplitMix64-finalizer of the seeded key plus the counter times the golden ratio,
+which is what SplitMix64 itself returns as its counter-th number.
+*/
+class CounterRandom {
+public:
+	CounterRandom() : key(mix(0)) {}
+	explicit CounterRandom(uint64_t seed) : key(mix(seed)) {}
+
+	uint64_t operator()(uint64_t counter) const {
+		return mix(key + (counter + 1) * GAMMA);
+	}
+
+	/*
+	31 random bits, as a non-negative int
+	*/
+	int index(uint64_t counter) const {
+		return (int)((*this)(counter) >> 33);
+	}
+
+private:
+	static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15ull;
+
+	static uint64_t mix(uint64_t x) {
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		return x ^ (x >> 31);
+	}
+
+	uint64_t key;
+};
+
+#endif
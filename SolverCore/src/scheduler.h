@@ -0,0 +1,111 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "buckets.h"
+
+/*
+Decides which radius-class gets the next circle. Every round each class adds its weight relative to the largest one
+and gets a circle whenever its accumulated weight reaches 1, the classes of one round in their order.
+Instead of stepping every class each round, a class waits in the round of its next circle,
+so it only costs something when it's due. The rounds ahead are kept in a ring of bitmaps of the waiting classes,
+which hands them out in their order without sorting; no class is stepped further ahead than the size of the ring.
+*/
+class RoundScheduler {
+public:
+	RoundScheduler() : current(0), word(0), words(0), active(0) {}
+
+	/*
+	Start with the weights of the classes; the largest one gets a circle every round
+	*/
+	void init(const std::vector<double>& weights) {
+		double maxWeight = 0.;
+		for (double weight : weights) {
+			maxWeight = std::max(maxWeight, weight);
+		}
+		states.resize(weights.size());
+		words = (weights.size() + 63) / 64;
+		waiting.assign(RING * words, 0);
+		current = 0;
+		word = words;
+		active = 0;
+		for (size_t i = 0; i < weights.size(); i++) {
+			states[i] = State{ maxWeight > 0. ? weights[i] / maxWeight : 0., 0., 0 };
+			if (states[i].share > 0.) {
+				advance((int)i);
+				active++;
+			}
+		}
+	}
+
+	/*
+	Class that gets the next circle, -1 if no class has any weight
+	*/
+	int next() {
+		if (active == 0) return -1;
+		while (true) {
+			uint64_t* round = &waiting[(current % RING) * words];
+			while (word < words && round[word] == 0) word++;
+			if (word == words) {
+				current++;
+				word = 0;
+				continue;
+			}
+
+			// lowest waiting class of the round
+			int bit = lowestBit(round[word]);
+			round[word] &= round[word] - 1;
+			int i = (int)(word * 64) + bit;
+			State& state = states[i];
+			bool due = state.weight >= 1.;
+			if (due) state.weight--;
+			advance(i);
+			if (due) return i;
+		}
+	}
+
+	/*
+	Round of the class returned last by next, starting at 1
+	*/
+	long long round() const {
+		return current;
+	}
+
+private:
+	// rounds kept ahead; a class that still isn't due after stepping that far is put back without a circle
+	static constexpr int RING = 64;
+
+	struct State {
+		double share;
+		double weight;
+		// last round whose share is contained in weight
+		long long round;
+	};
+
+	/*
+	Step a class through the rounds until its weight reaches 1, adding the share once per round like the rounds would
+	*/
+	void advance(int i) {
+		State& state = states[i];
+		long long last = current + RING - 1;
+		do {
+			state.round++;
+			state.weight += state.share;
+		} while (state.weight < 1. && state.round < last);
+		waiting[(state.round % RING) * words + i / 64] |= (uint64_t)1 << (i % 64);
+	}
+
+	std::vector<State> states;
+	// for every round of the ring one bit per class that is looked at in it
+	std::vector<uint64_t> waiting;
+	long long current;
+	// first word of the current round that can still have waiting classes
+	size_t word;
+	size_t words;
+	int active;
+};
+
+#endif
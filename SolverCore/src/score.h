@@ -0,0 +1,115 @@
+#ifndef SCORE_H
+#define SCORE_H
+
+#include <vector>
+#include <map>
+#include <queue>
+#include <utility>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795028841971
+#endif
+
+/*
+Score of circles in a rectangle: A is the covered part of the rectangle, D is 1 minus the Simpson-index of the circles
+grouped by type and B = A * D. Adding, removing and retyping a circle updates all three in constant time.
+Used by the Solver, the Checker and the Display, so they all score the same way.
+*/
+class Score {
+public:
+	Score(double w, double h, int typeCount)
+		: rect(w * h), size(0.), sumCountSquared(0.), total(0), counts(typeCount, 0), radii(typeCount, 0.) {
+	}
+
+	void add(int type, double r) {
+		sumCountSquared += 2. * (double)counts[type] + 1.;
+		counts[type]++;
+		total++;
+		size += r * r * PI;
+		radii[type] = r;
+	}
+
+	void remove(int type, double r) {
+		counts[type]--;
+		sumCountSquared -= 2. * (double)counts[type] + 1.;
+		total--;
+		size -= r * r * PI;
+	}
+
+	void retype(int from, int to) {
+		counts[from]--;
+		sumCountSquared -= 2. * (double)counts[from] + 1.;
+		sumCountSquared += 2. * (double)counts[to] + 1.;
+		counts[to]++;
+		radii[to] = radii[from];
+	}
+
+	double A() const {
+		return size / rect;
+	}
+
+	double D() const {
+		if (total == 0) return 0.;
+		return 1. - sumCountSquared / ((double)total * (double)total);
+	}
+
+	double B() const {
+		return A() * D();
+	}
+
+	int count() const {
+		return total;
+	}
+
+	int count(int type) const {
+		return counts[type];
+	}
+
+	/*
+	Remove single circles as long as that raises B, each time the one that raises it the most.
+	Only the most common type of every radius is a candidate, so a step costs one look at every radius.
+	Returns how many circles of every type were removed; which circles of a type is up to the caller.
+	*/
+	std::vector<int> reduce() {
+		// types of every radius by their count, the most common first
+		std::map<double, std::priority_queue<std::pair<int, int>>> byRadius;
+		for (int t = 0; t < (int)counts.size(); t++) {
+			if (counts[t] > 0) byRadius[radii[t]].push({ counts[t], t });
+		}
+
+		std::vector<int> removed(counts.size(), 0);
+		while (total > 1) {
+			double best = B();
+			std::priority_queue<std::pair<int, int>>* bestTypes = nullptr;
+			double n = (double)(total - 1);
+			for (auto& [r, types] : byRadius) {
+				int c = types.top().first;
+				if (c == 0) continue;
+				double b = (size - r * r * PI) / rect * (1. - (sumCountSquared - 2. * (double)c + 1.) / (n * n));
+				if (b > best) {
+					best = b;
+					bestTypes = &types;
+				}
+			}
+			if (!bestTypes) break;
+
+			auto [c, t] = bestTypes->top();
+			bestTypes->pop();
+			bestTypes->push({ c - 1, t });
+			remove(t, radii[t]);
+			removed[t]++;
+		}
+		return removed;
+	}
+
+private:
+	double rect;
+	double size;
+	double sumCountSquared;
+	int total;
+	std::vector<int> counts;
+	// radius of every type, as seen in add
+	std::vector<double> radii;
+};
+
+#endif
@@ -0,0 +1,1013 @@
+#include "solver.h"
+
+#include "utils.h"
+
+Solver::Solver()
+	: loaded(false), w(0.), h(0.), weighting(0.) {
+}
+
+Solver::~Solver() {
+}
+
+/*
+Initialize Solver with data from inputfile
+*/
+bool Solver::init(const std::string& inputfile)
+{
+	Input input;
+	loaded = readInput(inputfile, input);
+	if (!loaded) return false;
+	return init(input);
+}
+
+/*
+Initialize Solver with an input that was already read, so several solvers can share it
+*/
+bool Solver::init(const Input& input) {
+	w = input.w;
+	h = input.h;
+	types = input.types;
+
+	std::sort(types.begin(), types.end(), [](const CircleType& lhs, const CircleType& rhs) {
+		return lhs.r > rhs.r;
+	});
+
+	double r = 0;
+	radii = std::vector<double>();
+	classes = std::vector<RadiusClass>();
+	for (CircleType& t : types) {
+		if (r != t.r) {
+			classes.emplace_back((int)radii.size(), t.r);
+			radii.push_back(t.r);
+		}
+		r = t.r;
+		classes.back().typeIndices.push_back(t.index);
+	}
+	loaded = true;
+
+	grid.init(w, h, radii[0], radii.back());
+	conns_calculated.init((int)radii.size(), connections, fits);
+	conns_unknown.init(connections);
+	connGrid.init(w, h, radii[0] * 4, radii.back() * 2, connections);
+
+	reset();
+
+	return true;
+}
+
+/*
+Reset data for computation
+*/
+void Solver::reset() {
+	for (auto& radiusClass : classes) {
+		radiusClass.count = 0;
+	}
+
+	stats = RunStats();
+#ifdef DEBUG
+	connKeys.clear();
+#endif
+
+	// clearing keeps the memory, so repeated runs don't have to allocate again
+	connections.clear();
+	conns_unknown.clear();
+	conns_calculated.clear();
+	connGrid.clear();
+
+	conns_unknown.push(addConnection(Connection(Corner::TL)));
+	conns_unknown.push(addConnection(Connection(Corner::TR)));
+	conns_unknown.push(addConnection(Connection(Corner::BL)));
+	conns_unknown.push(addConnection(Connection(Corner::BR)));
+	circles.clear();
+
+	grid.clear();
+}
+
+/*
+Read input from file
+*/
+bool Solver::readInput(const std::string& path, Input& input) {
+	std::ifstream file;
+	file.open(path, std::ios::in);
+	if (!file.is_open()) return false;
+
+	std::string line;
+	std::getline(file, input.name);
+	std::getline(file, line);
+	size_t space = line.find(' ');
+	input.w = (double)std::stoi(line.substr(0, space));
+	input.h = (double)std::stoi(line.substr(space + 1));
+
+	input.types.clear();
+	int i = 0;
+	while (std::getline(file, line)) {
+		space = line.find(' ');
+		input.types.emplace_back(i, std::stod(line.substr(0, space)));
+		i++;
+	}
+
+	return true;
+}
+
+/*
+Write Result-object to outputfile
+*/
+bool Solver::writeOutput(Result& result, const std::string& outputfile) {
+	std::ofstream file;
+	file.open(outputfile, std::ios::out);
+	if (!file.is_open()) return false;
+
+	for (int i = 0; i < result.circleCountAtMax; i++) {
+		auto& c = result.circles[i];
+		file << std::setprecision(std::numeric_limits<double>::digits10) << c.cx << " " << c.cy << " " << c.r << " " << c.typeIndex << "\n";
+	}
+	file.close();
+	return true;
+}
+
+/*
+Run algorithm with the default policies
+*/
+Result Solver::run(double weighting, unsigned seed) {
+	return runWith<PerfectFitSelection, InterpolatedWeighting, NoImprovementStop>(weighting, seed);
+}
+
+/*
+Run algorithm with the given selection-, weighting- and stop-policy (see policies.h)
+*/
+template<typename Selection, typename Weighting, typename Stop>
+Result Solver::runWith(double weighting, unsigned seed) {
+	if (weighting > 2. || 0 > weighting) {
+		// only this run fails, the solver can still run with other weightings
+		if (observer) observer->error("Weightening must be between 0 and 2");
+		return Result();
+	}
+	this->weighting = weighting;
+
+	random = CounterRandom(seed);
+
+	if (!loaded) {
+		if (observer) observer->error("Could not run because the last Initialization failed");
+		return Result();
+	};
+
+	reset();
+
+	Score score(w, h, (int)types.size());
+	double maxB = 0.;
+	double maxA = 0.;
+	double maxD = 0.;
+	circleCountAtMax = 0;
+
+	double lastMax = 0.;
+	int sameFor = 0;
+	long long round = 1;
+	StopReason stopped = StopReason::NO_CONNECTIONS;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeLimit);
+	int untilClock = CLOCK_INTERVAL;
+	initWeights<Weighting>();
+	if (observer) observer->started(w, h);
+	while (true) {
+		if (stopFlag && stopFlag->load(std::memory_order_relaxed)) {
+			stopped = StopReason::INTERRUPTED;
+			goto finished;
+		}
+		if (timeLimit > 0. && --untilClock == 0) {
+			untilClock = CLOCK_INTERVAL;
+			if (std::chrono::steady_clock::now() >= deadline) {
+				stopped = StopReason::TIME_LIMIT;
+				goto finished;
+			}
+		}
+
+		int next = scheduler.next();
+		if (next == -1) goto finished;
+		if (scheduler.round() != round) {
+			if (observer) observer->round(circles);
+			round = scheduler.round();
+		}
+		if (conns_unknown.empty() && conns_calculated.empty()) goto finished;
+
+		// every type of the class gets a circle
+		RadiusClass& radiusClass = classes[next];
+		for (size_t k = 0; k < radiusClass.typeIndices.size(); k++) {
+			std::optional<PossibleCircle> pc = getNextCircle<Selection>(radiusClass);
+			if (!pc) continue;
+			Circle& circle = pc->circle;
+			circle.index = random.index(circles.size());
+			circle.typeIndex = radiusClass.nextType();
+			radiusClass.count++;
+
+			grid.insert(circle.cx, circle.cy, circle.r, (int)circles.size());
+			circles.push(circle);
+
+			updateConnections(circle);
+
+			for (auto& conn : pc->conns) {
+#ifdef DEBUG
+				if (!connKeys.insert(conn.key()).second) {
+					stats.connsDuplicate++;
+					continue;
+				}
+#endif
+				stats.connsCreated++;
+				// connections facing straight into a circle can't fit anything, so they don't have to be queued
+				if (!fitsSmallest(conn)) {
+					stats.connsFiltered++;
+					continue;
+				}
+				conns_unknown.push(addConnection(conn));
+			}
+
+			// calculate stats to find maximum
+			// should have deleted most common circle after finishing instead
+			score.add(circle.typeIndex, circle.r);
+			double A = score.A();
+			double D = score.D();
+			double B = A * D;
+
+			if (B > maxB) {
+				maxA = A;
+				maxD = D;
+				maxB = B;
+				circleCountAtMax = (int)circles.size();
+			}
+
+			if (maxCircles > 0 && (int)circles.size() >= maxCircles) {
+				stopped = StopReason::CIRCLE_LIMIT;
+				goto finished;
+			}
+
+			// end algorithm if there was no new maximum for a while
+			if (circles.size() % maxWindow == 0) {
+				if (lastMax == maxB) sameFor++;
+				else sameFor = 0;
+				lastMax = maxB;
+				if (observer) {
+					Progress progress{ maxA, maxD, maxB, circleCountAtMax, (int)circles.size(), B };
+#ifdef DEBUG
+					progress.dead = countDead();
+					progress.open = (int)(conns_unknown.size() + conns_calculated.size());
+#endif
+					observer->progress(progress);
+				}
+				if (Stop::done(sameFor, patience)) {
+					stopped = StopReason::CONVERGED;
+					goto finished;
+				}
+			}
+		}
+	}
+finished:
+	// remove circles of the most common types, starting at the maximum and with all circles
+	std::vector<Circle> kept, keptAll;
+	Score best = reduce(circleCountAtMax, kept);
+	Score all = reduce((int)circles.size(), keptAll);
+	if (all.B() > best.B()) {
+		best = all;
+		kept.swap(keptAll);
+	}
+
+	if (observer) {
+		stats.neighbourBytes = neighbours.size() * sizeof(NeighbourCache);
+		Summary summary{ stopped, (int)circles.size(), maxA, maxD, maxB, circleCountAtMax,
+			best.A(), best.D(), best.B(), (int)kept.size(), (int)types.size(), budget, stats };
+		observer->finished(summary, circles);
+	}
+
+	Result result(kept, best.A(), best.D(), best.B(), (int)kept.size());
+	result.stopped = stopped;
+	result.placed = (int)circles.size();
+	return result;
+}
+
+/*
+Score of the first count circles after removing the circles that lower it (see Score::reduce).
+The last placed circles of a type are removed; kept gets the others in their order.
+*/
+Score Solver::reduce(int count, std::vector<Circle>& kept) {
+	Score score(w, h, (int)types.size());
+	for (int i = 0; i < count; i++) {
+		Circle c = circles.get(i);
+		score.add(c.typeIndex, c.r);
+	}
+	std::vector<int> removed = score.reduce();
+
+	kept.clear();
+	for (int i = count - 1; i >= 0; i--) {
+		Circle c = circles.get(i);
+		if (removed[c.typeIndex] > 0) {
+			removed[c.typeIndex]--;
+			continue;
+		}
+		kept.push_back(c);
+	}
+	std::reverse(kept.begin(), kept.end());
+	return score;
+}
+
+/*
+Add a connection to the pool; it doesn't know its neighbours and the radii that fit yet
+*/
+int Solver::addConnection(const Connection& conn) {
+	int id = connections.add(conn);
+	if (id >= (int)neighbours.size()) {
+		neighbours.resize(id + 1);
+		fits.resize(id + 1);
+	}
+	neighbours[id].reset();
+	fits[id].reset((int)radii.size());
+	return id;
+}
+
+/*
+Remove a connection from the connection-grid and give its slot back to the pool
+*/
+void Solver::releaseConnection(int id) {
+	if (connections[id].gridCell >= 0) connGrid.remove(id);
+	connections.release(id);
+}
+
+/*
+Limit the number of unknown connections calculated for one circle, 0 means no limit.
+If the limit is reached, the best calculated connection is used, even if an unknown one would fit better.
+*/
+void Solver::setBudget(int budget) {
+	this->budget = budget;
+}
+
+/*
+Check for a new maximum every window circles and end the run after patience checks without one (with the improvement-stop).
+Both are at least 1.
+*/
+void Solver::setConvergence(int window, int patience) {
+	maxWindow = std::max(1, window);
+	this->patience = std::max(1, patience);
+}
+
+/*
+End runs after the given number of seconds or circles, 0 means no limit.
+The run returns the best circles placed so far, like a run that ended by itself.
+*/
+void Solver::setLimits(double seconds, int maxCircles) {
+	timeLimit = seconds;
+	this->maxCircles = maxCircles;
+}
+
+/*
+Where the progress and statistics of runs go, none if null (default)
+*/
+void Solver::setObserver(SolverObserver* observer) {
+	this->observer = observer;
+}
+
+/*
+Flag that ends the current run as soon as it's set, e.g. from a signal-handler; the caller keeps it alive.
+Several solvers can share one flag.
+*/
+void Solver::setStopFlag(const std::atomic<bool>* flag) {
+	stopFlag = flag;
+}
+
+/*
+Select when connections near new circles are checked again
+*/
+void Solver::setRevalidation(Revalidation mode) {
+	revalidation = mode;
+}
+
+/*
+Calculate the weight of every radius-class once per run; all types of a class have the same weight
+*/
+template<typename Weighting>
+void Solver::initWeights() {
+	weights.clear();
+	for (auto& radiusClass : classes) {
+		weights.push_back(Weighting::weight(radiusClass.r, weighting));
+	}
+	scheduler.init(weights);
+}
+
+/*
+Update the connections near the newly placed circle, which has already been added to the circles.
+The circle only blocks the radii whose circle it overlaps, so it is only tested against their centers; the other radii
+of a connection still fit. Connections where nothing fits anymore are retired.
+*/
+void Solver::updateConnections(const Circle& circle) {
+	invalid.clear();
+	// only connections whose area contains the circle have to be checked
+	connGrid.forEachNear(circle.cx, circle.cy, circle.r, [&](int id) {
+		// lazy connections are checked when they are selected, until then only their neighbours are kept
+		if (revalidation == Revalidation::LAZY) {
+			NeighbourCache& cache = neighbours[id];
+			if (cache.known && cache.contains(circle.cx, circle.cy, circle.r)) cache.add((int)circles.size() - 1);
+			return;
+		}
+		const std::vector<Fit>& connFits = fits[id].fits;
+		if (!connections[id].calculated) return;
+		if (std::any_of(connFits.begin(), connFits.end(), [&](const Fit& fit) { return blocks(circle, fit); })) invalid.push_back(id);
+	});
+
+	for (int id : invalid) {
+		removeFits(id, [&](const Fit& fit) { return blocks(circle, fit); });
+		stats.connsUpdated++;
+		if (fits[id].empty()) stats.connsRetired++;
+	}
+}
+
+/*
+Remove the radii of a calculated connection for which blocked(fit) is true and move it to the buckets of the radii left,
+or release it if none is left. Returns false if no radius was blocked.
+*/
+template<typename F>
+bool Solver::removeFits(int id, F blocked) {
+	FitSet& set = fits[id];
+	if (std::none_of(set.fits.begin(), set.fits.end(), blocked)) return false;
+
+	conns_calculated.remove(id);
+	connections[id].calculated = false;
+	set.removeIf(blocked);
+	if (set.empty()) {
+		releaseConnection(id);
+	} else {
+		addCalculated(id);
+	}
+	return true;
+}
+
+/*
+Check if a circle overlaps the circle of a fit; same test as checkValid
+*/
+bool Solver::blocks(const Circle& circle, const Fit& fit) {
+	return anyOverlapScalar(&circle.cx, &circle.cy, &circle.r, 1, fit.center.x, fit.center.y, radii[fit.radiusIndex]);
+}
+
+/*
+Try to find a good position for a circle of the provided radius-class
+*/
+template<typename Selection>
+std::optional<PossibleCircle> Solver::getNextCircle(const RadiusClass& t) {
+	// Connection where the radius of provided type fits perfectly was already calculated?
+	int best;
+	if constexpr (Selection::stopAtPerfectFit) {
+		best = findCalculated(t.radiusIndex);
+		if (best != -1 && fitsPerfectly(best, t.radiusIndex)) {
+			return getCircleFromConnection(connections[best], t.r);
+		}
+	}
+
+	// calculate until good connection found or the budget is used up
+	for (int evaluated = 0; !conns_unknown.empty(); evaluated++) {
+		if (budget > 0 && evaluated == budget) {
+			stats.budgetExhausted++;
+			break;
+		}
+		int id = conns_unknown.pop();
+		Connection& conn = connections[id];
+		calcFits(id);
+		stats.connsEvaluated++;
+		// add to calculated if any radius fits, otherwise it can't be used anymore
+		if (!fits[id].empty()) {
+			addCalculated(id);
+		} else {
+			releaseConnection(id);
+			stats.connsDropped++;
+		}
+		// found perfect match?
+		if constexpr (Selection::stopAtPerfectFit) {
+			if (fitsPerfectly(id, t.radiusIndex)) {
+				return getCircleFromConnection(conn, t.r);
+			}
+		}
+	}
+
+	// no good connection => find next best
+	best = findCalculated(t.radiusIndex);
+	if (best == -1) {
+		return std::nullopt;
+	}
+	return getCircleFromConnection(connections[best], t.r);
+}
+
+/*
+Best calculated connection for a radius-index, see ConnectionBuckets::find.
+Lazy connections may have been calculated before some of the circles were placed; the radii blocked by the circles placed
+since then are removed, which moves the connection to other buckets.
+*/
+int Solver::findCalculated(int radiusIndex) {
+	while (true) {
+		int best = conns_calculated.find(radiusIndex);
+		if (best == -1 || revalidation == Revalidation::EAGER) return best;
+
+		Connection& conn = connections[best];
+		FitSet& set = fits[best];
+		bool changed;
+		// calculating again is cheaper than going through a long placement log
+		if ((int)circles.size() - conn.epoch > LAZY_LOG_LIMIT) {
+			const NeighbourCache& cache = neighbours[best];
+			changed = removeFits(best, [&](const Fit& fit) {
+				double r = radii[fit.radiusIndex];
+				return !checkValid(fit.center.x, fit.center.y, r, usableNeighbours(cache, r));
+			});
+			stats.connsEvaluated++;
+		} else {
+			nearby.clear();
+			for (int i = conn.epoch; i < (int)circles.size(); i++) {
+				if (set.contains(circles.cx[i], circles.cy[i], circles.r[i])) nearby.push_back(i);
+			}
+			changed = removeFits(best, [&](const Fit& fit) {
+				return std::any_of(nearby.begin(), nearby.end(), [&](int i) { return blocks(circles.get(i), fit); });
+			});
+			if (!nearby.empty()) stats.connsUpdated++;
+		}
+		if (!changed) {
+			// still valid for all circles up to now
+			conn.epoch = (int)circles.size();
+			return best;
+		}
+		if (fits[best].empty()) stats.connsDropped++;
+	}
+}
+
+/*
+Whether a radius fits at a connection and the next larger one doesn't
+*/
+bool Solver::fitsPerfectly(int id, int radiusIndex) {
+	const FitSet& set = fits[id];
+	return set.has(radiusIndex) && (radiusIndex == 0 || !set.has(radiusIndex - 1));
+}
+
+/*
+Add a connection with calculated fits. Its position among equally good connections depends on the random index of its first circle.
+Eager connections are indexed by the area of the circles of their fits, in which a new circle can block them (see updateConnections),
+lazy ones by the area of their neighbours, so new circles can be added to them.
+*/
+void Solver::addCalculated(int id) {
+	Connection& conn = connections[id];
+	FitSet& set = fits[id];
+	conn.epoch = (int)circles.size();
+	conn.calculated = true;
+	conn.radiusIndex = set.fits[0].radiusIndex;
+	conn.maxRadius = radii[conn.radiusIndex];
+	conns_calculated.insert(id, conn.c1 < 0 ? 0u : (unsigned)circles.index[conn.c1]);
+	set.updateArea(radii);
+
+	std::array<double, 4> area = set.area;
+	if (revalidation == Revalidation::LAZY) {
+		const NeighbourCache& cache = neighbours[id];
+		if (!cache.known) area[0] = std::numeric_limits<double>::infinity();
+		else area = cache.area;
+	}
+
+	if (conn.gridCell >= 0) connGrid.remove(id);
+	if (area[0] > area[2]) return;
+	connGrid.insert(id, (area[0] + area[2]) / 2., (area[1] + area[3]) / 2., std::max(area[2] - area[0], area[3] - area[1]) / 2.);
+}
+
+/*
+Check if circle collides. If the neighbours of the connection the circle is placed at are known, only they are checked.
+*/
+bool Solver::checkValid(double cx, double cy, double r, const NeighbourCache* near) {
+	if (cx < r) return false;
+	if (cy < r) return false;
+	if (cx + r > w) return false;
+	if (cy + r > h) return false;
+
+	if (near) {
+		stats.checkHits++;
+		stats.neighbourSize += near->count;
+		for (int k = 0; k < near->count; k++) {
+			int i = near->circles[k];
+			if (anyOverlapScalar(&circles.cx[i], &circles.cy[i], &circles.r[i], 1, cx, cy, r)) return false;
+		}
+		return true;
+	}
+
+	// only circles in nearby cells can collide
+	stats.checkMisses++;
+	return !grid.anyOverlap(cx, cy, r);
+}
+
+/*
+Calculate the position of a circle with radius r placed at a connection
+*/
+Point Solver::getPosition(const Connection& conn, double r) {
+	if (conn.type == ConnType::CORNER) {
+		if (conn.corner == Corner::TL) return Point{r, r};
+		if (conn.corner == Corner::TR) return Point{w - r, r};
+		if (conn.corner == Corner::BL) return Point{r, h - r};
+		return Point{w - r, h - r};
+	} else if (conn.type == ConnType::WALL) {
+		Circle c = circles.get(conn.c1);
+		double wd = 2 * std::sqrt(c.r * r) * (conn.left ? 1 : -1);
+		if (conn.wall == Wall::UP) return Point{c.cx - wd, r};
+		if (conn.wall == Wall::LEFT) return Point{r, c.cy + wd};
+		if (conn.wall == Wall::DOWN) return Point{c.cx + wd, h - r};
+		return Point{w - r, c.cy - wd};
+	}
+	Circle c1 = circles.get(conn.c1);
+	Circle c2 = circles.get(conn.c2);
+	if (!conn.left) {
+		std::swap(c1, c2);
+	}
+	return intersectionTwoCircles(c1.cx, c1.cy, c1.r + r, c2.cx, c2.cy, c2.r + r);
+}
+
+/*
+Calculate the radii that fit at a connection.
+The gap is the largest radius up to which circles placed at the connection fit. It's the first radius at which
+the placed circle would touch a neighbouring circle or a wall and can be calculated directly, so one search finds
+all radii up to it. Larger radii can fit again, e.g. if the first touch is a small circle that a larger circle,
+placed further out, clears; every larger radius up to the walls is tested on its own (see probeFit).
+A connection calculated before only tests the radii that fitted then, because circles are never removed.
+*/
+void Solver::calcFits(int id) {
+	Connection& conn = connections[id];
+	FitSet& set = fits[id];
+	NeighbourCache& cache = neighbours[id];
+	if (set.known) {
+		set.removeIf([&](const Fit& fit) {
+			double r = radii[fit.radiusIndex];
+			return !checkValid(fit.center.x, fit.center.y, r, usableNeighbours(cache, r));
+		});
+		return;
+	}
+	set.known = true;
+
+	int n = (int)radii.size();
+	double rmin = radii.back();
+	// radii above the limit touch a wall, they aren't tested
+	double limit = radii[0];
+	// first radius-index of the radii up to the gap
+	int i = n;
+	Point p = getMinPosition(conn);
+	if (checkValid(p.x, p.y, rmin, usableNeighbours(cache, rmin))) {
+		double gap = radii[0];
+		if (conn.type == ConnType::CIRCLE) {
+			gap = calcGapCircle(conn, rmin, gap, cache, limit);
+		} else if (conn.type == ConnType::WALL) {
+			gap = calcGapWall(conn, rmin, gap, cache, limit);
+		} else if (conn.type == ConnType::CORNER) {
+			gap = calcGapCorner(conn, rmin, gap, cache, limit);
+		}
+
+		// radii are sorted from largest to smallest
+		i = (int)(std::lower_bound(radii.begin(), radii.end(), gap + RADIUS_EPSILON, std::greater<double>()) - radii.begin());
+
+		// the gap is only exact up to rounding, so the first radius is checked once
+		while (i < n - 1) {
+			p = getPosition(conn, radii[i]);
+			if (checkValid(p.x, p.y, radii[i], usableNeighbours(cache, radii[i]))) break;
+			i++;
+		}
+	}
+
+	// larger radii from the largest one, the radii up to the gap after them
+	blockers.clear();
+	int past = 0;
+	for (int j = 0; j < i; j++) {
+		if (radii[j] > limit + RADIUS_EPSILON) continue;
+		p = getPosition(conn, radii[j]);
+		if (!probeFit(p.x, p.y, radii[j])) continue;
+		set.add(j, p);
+		past++;
+	}
+	for (int j = i; j < n; j++) {
+		set.add(j, getPosition(conn, radii[j]));
+	}
+	stats.fitsPastGap += past;
+}
+
+/*
+Check if a circle fits, like checkValid. The circles that blocked the last radii are tested first, because a circle usually blocks
+a whole range of radii, and the circle found in the grid becomes one of them.
+*/
+bool Solver::probeFit(double cx, double cy, double r) {
+	if (cx < r || cy < r || cx + r > w || cy + r > h) return false;
+	for (int i : blockers) {
+		if (anyOverlapScalar(&circles.cx[i], &circles.cy[i], &circles.r[i], 1, cx, cy, r)) return false;
+	}
+	stats.checkMisses++;
+	int i = grid.findOverlap(cx, cy, r);
+	if (i == -1) return true;
+	blockers.push_back(i);
+	return false;
+}
+
+/*
+Position of the smallest circle at a connection. It doesn't change, so it is only calculated once.
+*/
+const Point& Solver::getMinPosition(Connection& conn) {
+	if (!conn.minPosKnown) {
+		conn.minPos = getPosition(conn, radii.back());
+		conn.minPosKnown = true;
+	}
+	return conn.minPos;
+}
+
+/*
+The cache if it contains every circle that could collide with a circle of radius r at its connection, nullptr otherwise
+*/
+const NeighbourCache* Solver::usableNeighbours(const NeighbourCache& cache, double r) {
+	return cache.known && r <= cache.reach ? &cache : nullptr;
+}
+
+/*
+Check if the smallest circle fits at a connection. New connections where it doesn't fit face straight into a circle;
+larger radii rarely clear it, so they are dropped without a calculation.
+*/
+bool Solver::fitsSmallest(Connection& conn) {
+	const Point& p = getMinPosition(conn);
+	return checkValid(p.x, p.y, radii.back());
+}
+
+#ifdef DEBUG
+/*
+Count the live connections where no radius fits anymore
+*/
+int Solver::countDead() {
+	int dead = 0;
+	conns_unknown.forEach([&](int id) {
+		Connection& conn = connections[id];
+		bool fit = false;
+		for (int i = 0; i < (int)radii.size() && !fit; i++) {
+			Point p = getPosition(conn, radii[i]);
+			fit = checkValid(p.x, p.y, radii[i]);
+		}
+		if (!fit) dead++;
+	});
+	conns_calculated.forEach([&](int id) {
+		const std::vector<Fit>& connFits = fits[id].fits;
+		bool fit = std::any_of(connFits.begin(), connFits.end(), [&](const Fit& f) {
+			return checkValid(f.center.x, f.center.y, radii[f.radiusIndex]);
+		});
+		if (!fit) dead++;
+	});
+	return dead;
+}
+#endif
+
+/*
+Area the center of a circle placed at a connection can be in for radii from lo up to hi
+*/
+std::array<double, 4> Solver::gapBounds(const Connection& conn, double lo, double hi) {
+	if (conn.type == ConnType::CIRCLE) {
+		// the center is at most r1 + hi away from c1 and r2 + hi away from c2
+		int c1 = conn.c1, c2 = conn.c2;
+		return std::array<double, 4>{
+			std::max(circles.cx[c1] - circles.r[c1], circles.cx[c2] - circles.r[c2]) - hi, std::max(circles.cy[c1] - circles.r[c1], circles.cy[c2] - circles.r[c2]) - hi,
+			std::min(circles.cx[c1] + circles.r[c1], circles.cx[c2] + circles.r[c2]) + hi, std::min(circles.cy[c1] + circles.r[c1], circles.cy[c2] + circles.r[c2]) + hi
+		};
+	}
+	// corner- and wall-circles move away from the wall as they grow
+	Point a = getPosition(conn, lo), b = getPosition(conn, hi);
+	return std::array<double, 4>{ std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x), std::max(a.y, b.y) };
+}
+
+/*
+Find the first radius in (lo, gap] at which the circle placed at a connection touches a neighbour.
+touch(cx, cy, r) returns the first radius at which the circle touches the neighbour (cx, cy, r).
+If the neighbours of the connection are known only they are tested. Otherwise the search starts close to the connection
+and only looks further out if nothing was found; the circles of the last area become the neighbours of the connection.
+*/
+template<typename Touch>
+double Solver::searchGap(const Connection& conn, double lo, double gap, NeighbourCache& cache, Touch touch) {
+	if (usableNeighbours(cache, gap)) {
+		stats.neighbourHits++;
+		stats.neighbourSize += cache.count;
+		std::array<double, 4> b = gapBounds(conn, lo, gap);
+		double reach = gap;
+		for (int k = 0; k < cache.count; k++) {
+			int i = cache.circles[k];
+			// same test as Grid::forEachNear
+			double d = reach + circles.r[i];
+			if (circles.cx[i] < b[0] - d || circles.cx[i] > b[2] + d || circles.cy[i] < b[1] - d || circles.cy[i] > b[3] + d) continue;
+			gap = std::min(gap, touch(circles.cx[i], circles.cy[i], circles.r[i]));
+		}
+		return gap;
+	}
+
+	stats.neighbourMisses++;
+	for (double hi = std::min(gap, 2. * lo); ; hi = std::min(gap, 2. * hi)) {
+		std::array<double, 4> b = gapBounds(conn, lo, hi);
+		cache.reset();
+		bool complete = true;
+		grid.forEachNear(b[0], b[1], b[2], b[3], hi, [&](double cx, double cy, double r, int i) {
+			gap = std::min(gap, touch(cx, cy, r));
+			if (complete) complete = cache.add(i);
+		});
+		// every circle that could touch before hi was tested
+		if (gap <= hi) {
+			if (complete) {
+				cache.known = true;
+				cache.reach = hi;
+				cache.area = std::array<double, 4>{ b[0] - hi, b[1] - hi, b[2] + hi, b[3] + hi };
+			}
+			return gap;
+		}
+	}
+}
+
+/*
+Calculate the gap of a corner-connection; limit gets the gap of the walls alone
+*/
+double Solver::calcGapCorner(const Connection& conn, double lo, double gap, NeighbourCache& cache, double& limit) {
+	// mirror everything, so the corner is at (0;0)
+	bool right = conn.corner == Corner::TR || conn.corner == Corner::BR;
+	bool bottom = conn.corner == Corner::BL || conn.corner == Corner::BR;
+
+	// opposite walls
+	gap = std::min({gap, w / 2., h / 2.});
+	limit = gap;
+
+	return searchGap(conn, lo, gap, cache, [&](double cx, double cy, double cr) {
+		double x = right ? w - cx : cx;
+		double y = bottom ? h - cy : cy;
+		// (r - x)^2 + (r - y)^2 = (r + cr)^2
+		return firstNegative(1., -2. * (x + y + cr), x * x + y * y - cr * cr, lo);
+	});
+}
+
+/*
+Calculate the gap of a wall-circle-connection; limit gets the gap of the walls alone
+*/
+double Solver::calcGapWall(const Connection& conn, double lo, double gap, NeighbourCache& cache, double& limit) {
+	Circle c = circles.get(conn.c1);
+
+	// use coordinates along (t) and away from (n) the wall; the circle center is at t = ct + s * sqrt(r), n = r
+	bool horizontal = conn.wall == Wall::UP || conn.wall == Wall::DOWN;
+	double length = horizontal ? w : h;
+	double depth = horizontal ? h : w;
+	double ct = horizontal ? c.cx : c.cy;
+	double s = 2. * std::sqrt(c.r) * (conn.left ? 1 : -1) * ((conn.wall == Wall::UP || conn.wall == Wall::RIGHT) ? -1 : 1);
+
+	// everything is quadratic in u = sqrt(r)
+	double ulo = std::sqrt(lo);
+	auto toRadius = [](double u) { return u * u; };
+
+	// ends of the wall and opposite wall
+	gap = std::min(gap, toRadius(firstNegative(-1., s, ct, ulo)));
+	gap = std::min(gap, toRadius(firstNegative(-1., -s, length - ct, ulo)));
+	gap = std::min(gap, depth / 2.);
+	limit = gap;
+
+	return searchGap(conn, lo, gap, cache, [&](double cx, double cy, double cr) {
+		double kt = horizontal ? cx : cy;
+		double kn = 0.;
+		if (conn.wall == Wall::UP) kn = cy;
+		else if (conn.wall == Wall::LEFT) kn = cx;
+		else if (conn.wall == Wall::DOWN) kn = h - cy;
+		else if (conn.wall == Wall::RIGHT) kn = w - cx;
+		// (ct + s * u - kt)^2 + (u^2 - kn)^2 = (u^2 + cr)^2
+		double a = ct - kt;
+		return toRadius(firstNegative(s * s - 2. * (kn + cr), 2. * a * s, a * a + kn * kn - cr * cr, ulo));
+	});
+}
+
+/*
+Calculate the gap of a circle-circle-connection; limit gets the gap of the walls alone
+*/
+double Solver::calcGapCircle(const Connection& conn, double lo, double gap, NeighbourCache& cache, double& limit) {
+	Circle c1 = circles.get(conn.c1);
+	Circle c2 = circles.get(conn.c2);
+	if (!conn.left) {
+		std::swap(c1, c2);
+	}
+
+	// coordinates relative to c1; the circle center (x;y) is on the line x2 * x + y2 * y = e2 + f2 * r
+	double x2 = c2.cx - c1.cx, y2 = c2.cy - c1.cy;
+	double e2 = (x2 * x2 + y2 * y2 - c2.r * c2.r + c1.r * c1.r) / 2.;
+	double f2 = c1.r - c2.r;
+	auto touch = [&](double a, double b, double e, double f) {
+		return firstTouchTwoCircles(x2, y2, e2, f2, c1.r, a, b, e, f, lo);
+	};
+
+	// walls
+	gap = std::min(gap, touch(1., 0., -c1.cx, 1.));
+	gap = std::min(gap, touch(1., 0., w - c1.cx, -1.));
+	gap = std::min(gap, touch(0., 1., -c1.cy, 1.));
+	gap = std::min(gap, touch(0., 1., h - c1.cy, -1.));
+	limit = gap;
+
+	return searchGap(conn, lo, gap, cache, [&](double cx, double cy, double cr) {
+		double xk = cx - c1.cx, yk = cy - c1.cy;
+		return touch(xk, yk, (xk * xk + yk * yk - cr * cr + c1.r * c1.r) / 2., c1.r - cr);
+	});
+}
+
+/*
+Construct a circle and its connections from a connection
+*/
+PossibleCircle Solver::getCircleFromConnection(const Connection& conn, double r) {
+	if (conn.type == ConnType::CIRCLE) {
+		return getCircleFromCircle(conn.c1, conn.c2, r, conn.left);
+	} else if (conn.type == ConnType::WALL) {
+		return getCircleFromWall(conn, r);
+	}
+	return getCirclFromCorner(conn.corner, r);
+}
+
+/*
+Construct a circle from a corner-connection
+*/
+PossibleCircle Solver::getCirclFromCorner(Corner corner, double r) {
+	Circle c(0., 0., r);
+	int ci = (int)circles.size();
+	Wall wx = Wall::LEFT, wy = Wall::UP;
+	if (corner == Corner::TL) {
+		c.cx = r;
+		c.cy = r;
+	} else if (corner == Corner::TR) {
+		c.cx = w - r;
+		c.cy = r;
+		wx = Wall::RIGHT;
+	} else if (corner == Corner::BL) {
+		c.cx = r;
+		c.cy = h - r;
+		wy = Wall::DOWN;
+	} else if (corner == Corner::BR) {
+		c.cx = w - r;
+		c.cy = h - r;
+		wx = Wall::RIGHT;
+		wy = Wall::DOWN;
+	}
+	return PossibleCircle(c, {
+		Connection(ci, wx, true),
+		Connection(ci, wx, false),
+		Connection(ci, wy, true),
+		Connection(ci, wy, false)
+	});
+}
+
+/*
+Construct a circle from a wall-circle-connection
+*/
+PossibleCircle Solver::getCircleFromWall(const Connection& conn, double r) {
+	Circle c1 = circles.get(conn.c1);
+	double wd = 2 * std::sqrt(c1.r * r) * (conn.left ? 1 : -1);
+	Circle c(0., 0., r);
+	int ci = (int)circles.size();
+	if (conn.wall == Wall::UP) {
+		c.cx = c1.cx - wd;
+		c.cy = r;
+	} else if (conn.wall == Wall::LEFT) {
+		c.cx = r;
+		c.cy = c1.cy + wd;
+	} else if (conn.wall == Wall::DOWN) {
+		c.cx = c1.cx + wd;
+		c.cy = h - r;
+	} else if (conn.wall == Wall::RIGHT) {
+		c.cx = w - r;
+		c.cy = c1.cy - wd;
+	}
+	return PossibleCircle(c, {
+		Connection(ci, conn.c1, true),
+		Connection(ci, conn.c1, false),
+		Connection(ci, conn.wall, true),
+		Connection(ci, conn.wall, false)
+	});
+}
+
+/*
+Construct a circle from a circle-circle-connection
+*/
+PossibleCircle Solver::getCircleFromCircle(int c1, int c2, double r, bool left) {
+	Circle n = left ? circleFromTwoCircles(circles.get(c1), circles.get(c2), r) : circleFromTwoCircles(circles.get(c2), circles.get(c1), r);
+	int ni = (int)circles.size();
+	return PossibleCircle(n, {
+		Connection(ni, c1, true),
+		Connection(ni, c1, false),
+		Connection(ni, c2, true),
+		Connection(ni, c2, false)
+	});
+}
+
+template<typename Selection, typename Weighting, typename Stop>
+static void addRun(std::map<std::string, Solver::RunFunction>& runs) {
+	runs[std::string(Selection::name) + "," + Weighting::name + "," + Stop::name] = &Solver::runWith<Selection, Weighting, Stop>;
+}
+
+template<typename Selection, typename Weighting>
+static void addStops(std::map<std::string, Solver::RunFunction>& runs) {
+	addRun<Selection, Weighting, NoImprovementStop>(runs);
+	addRun<Selection, Weighting, ExhaustedStop>(runs);
+}
+
+template<typename Selection>
+static void addWeightings(std::map<std::string, Solver::RunFunction>& runs) {
+	addStops<Selection, InterpolatedWeighting>(runs);
+	addStops<Selection, PowerWeighting>(runs);
+}
+
+/*
+Run-functions for every combination of policies by "SELECTION,WEIGHTING,STOP"
+*/
+const std::map<std::string, Solver::RunFunction>& Solver::registry() {
+	static const std::map<std::string, RunFunction> runs = [] {
+		std::map<std::string, RunFunction> runs;
+		addWeightings<PerfectFitSelection>(runs);
+		addWeightings<ExhaustiveSelection>(runs);
+		return runs;
+	}();
+	return runs;
+}
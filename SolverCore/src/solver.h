@@ -0,0 +1,162 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "utils.h"
+#include "grid.h"
+#include "buckets.h"
+#include "conngrid.h"
+#include "neighbours.h"
+#include "fits.h"
+#include "policies.h"
+#include "scheduler.h"
+#include "score.h"
+#include "observer.h"
+#include "random.h"
+
+#include <map>
+#include <chrono>
+#include <atomic>
+
+/*
+When connections near a newly placed circle are checked again:
+EAGER removes the radii it blocks right away,
+LAZY keeps them and only checks them against the circles placed since their calculation once they are selected.
+*/
+enum class Revalidation {
+	EAGER,
+	LAZY
+};
+
+// lazy connections calculated more than this many circles ago are calculated again instead of checking the placement log
+#define LAZY_LOG_LIMIT 4096
+
+// circles tried between two looks at the clock when the run has a time limit
+#define CLOCK_INTERVAL 256
+
+class Solver {
+public:
+	Solver();
+	virtual ~Solver();
+
+	bool init(const std::string& inputfile);
+	bool init(const Input& input);
+
+	void reset();
+
+	static bool readInput(const std::string& path, Input& input);
+	bool writeOutput(Result& result, const std::string& outputfile);
+
+	Result run(double weighting, unsigned seed);
+	template<typename Selection, typename Weighting, typename Stop>
+	Result runWith(double weighting, unsigned seed);
+
+	typedef Result (Solver::*RunFunction)(double weighting, unsigned seed);
+	static const std::map<std::string, RunFunction>& registry();
+
+	template<typename Weighting>
+	void initWeights();
+
+	Score reduce(int count, std::vector<Circle>& kept);
+
+	void setRevalidation(Revalidation mode);
+	void setBudget(int budget);
+	void setConvergence(int window, int patience);
+	void setLimits(double seconds, int maxCircles);
+	void setObserver(SolverObserver* observer);
+	void setStopFlag(const std::atomic<bool>* flag);
+
+	int addConnection(const Connection& conn);
+	void releaseConnection(int id);
+
+	void updateConnections(const Circle& circle);
+	template<typename F>
+	bool removeFits(int id, F blocked);
+	bool blocks(const Circle& circle, const Fit& fit);
+	
+	template<typename Selection>
+	std::optional<PossibleCircle> getNextCircle(const RadiusClass& t);
+	int findCalculated(int radiusIndex);
+	bool fitsPerfectly(int id, int radiusIndex);
+
+	bool checkValid(double cx, double cy, double r, const NeighbourCache* near = nullptr);
+
+	Point getPosition(const Connection& conn, double r);
+
+	void calcFits(int id);
+	bool probeFit(double cx, double cy, double r);
+	const NeighbourCache* usableNeighbours(const NeighbourCache& cache, double r);
+	const Point& getMinPosition(Connection& conn);
+	bool fitsSmallest(Connection& conn);
+#ifdef DEBUG
+	int countDead();
+#endif
+	void addCalculated(int id);
+	double calcGapCorner(const Connection& conn, double lo, double gap, NeighbourCache& cache, double& limit);
+	double calcGapWall(const Connection& conn, double lo, double gap, NeighbourCache& cache, double& limit);
+	double calcGapCircle(const Connection& conn, double lo, double gap, NeighbourCache& cache, double& limit);
+
+	std::array<double, 4> gapBounds(const Connection& conn, double lo, double hi);
+	template<typename Touch>
+	double searchGap(const Connection& conn, double lo, double gap, NeighbourCache& cache, Touch touch);
+
+	PossibleCircle getCircleFromConnection(const Connection& conn, double r);
+	PossibleCircle getCirclFromCorner(Corner corner, double r);
+	PossibleCircle getCircleFromWall(const Connection& conn, double r);
+	PossibleCircle getCircleFromCircle(int c1, int c2, double r, bool left);
+
+private:
+	double w, h;
+	std::vector<CircleType> types;
+	std::vector<RadiusClass> classes;
+
+	CircleStore circles;
+	Grid grid;
+
+	ConnectionPool connections;
+	ConnectionBuckets conns_calculated;
+	ConnectionGrid connGrid;
+	ConnectionQueue conns_unknown;
+	// connections with radii blocked by the last placed circle
+	std::vector<int> invalid;
+	// neighbours and radii that fit of every connection, by id
+	std::vector<NeighbourCache> neighbours;
+	std::vector<FitSet> fits;
+	// circles that blocked radii of the connection that is calculated, which likely block the next radius as well
+	std::vector<int> blockers;
+	// circles placed near a lazy connection since its calculation
+	std::vector<int> nearby;
+
+	// statistics about the connections of the current run
+	RunStats stats;
+#ifdef DEBUG
+	// every connection is created only once; checked in debug-builds
+	std::set<std::tuple<ConnType, int, int, bool>> connKeys;
+#endif
+
+	std::vector<double> radii;
+
+	int circleCountAtMax = 0;
+	double weighting;
+	Revalidation revalidation = Revalidation::EAGER;
+	// unknown connections calculated per circle at most, 0 means no limit
+	int budget = 0;
+	// circles between two checks for a new maximum and checks without one until the run is done
+	int maxWindow = 1000;
+	int patience = 2;
+	// the run ends after this many seconds or circles, 0 means no limit
+	double timeLimit = 0.;
+	int maxCircles = 0;
+	// owned by the caller, e.g. set from a signal-handler; ends the current run with the best circles so far
+	const std::atomic<bool>* stopFlag = nullptr;
+	// weight of every radius-class in the current run
+	std::vector<double> weights;
+	RoundScheduler scheduler;
+
+	bool loaded;
+	// random numbers of the current run by the ordinal of the circle, keyed with its seed
+	CounterRandom random;
+	// gets the progress and statistics of runs, none if null
+	SolverObserver* observer = nullptr;
+};
+
+#endif
\ No newline at end of file
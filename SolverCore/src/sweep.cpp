@@ -0,0 +1,155 @@
+#include "sweep.h"
+
+#include <thread>
+#include <chrono>
+
+Sweep::Sweep(const Input& input, const std::string& inputName, Solver::RunFunction run)
+	: input(input), inputName(inputName), runFunction(run), threads(1), records(nullptr), json(false), stopFlag(nullptr), header(false), next(0), done(0), failedWrites(0) {
+}
+
+void Sweep::setSetup(std::function<void(Solver&)> setup) {
+	this->setup = setup;
+}
+
+/*
+Number of threads, at least 1
+*/
+void Sweep::setThreads(int threads) {
+	this->threads = std::max(1, threads);
+}
+
+void Sweep::setRecords(std::ostream* out, bool json) {
+	records = out;
+	this->json = json;
+}
+
+/*
+Ends the sweep as soon as it's set: running jobs return their best circles so far and the others are skipped
+*/
+void Sweep::setStopFlag(const std::atomic<bool>* flag) {
+	stopFlag = flag;
+}
+
+/*
+File that always holds the best result of the sweep, none if empty
+*/
+void Sweep::setOutput(const std::string& path) {
+	output = path;
+}
+
+/*
+Run all jobs and return the best record of all runs of this sweep, which is also the one in the output-file (B is -1 if there was none).
+Can be called again with other jobs or another setup, e.g. for the rounds of a Race.
+*/
+SweepRecord Sweep::run(const std::vector<SweepJob>& jobs) {
+	next = 0;
+	done = 0;
+	failedWrites = 0;
+	results.assign(jobs.size(), SweepRecord());
+
+	if (records && !json && !header) {
+		*records << "input,weighting,seed,B,A,D,circles,placed,stopped,seconds" << std::endl;
+		header = true;
+	}
+
+	std::vector<std::thread> pool;
+	int count = (int)std::min((size_t)threads, jobs.size());
+	for (int i = 0; i < count; i++) {
+		pool.emplace_back(&Sweep::work, this, std::cref(jobs));
+	}
+	for (auto& thread : pool) {
+		thread.join();
+	}
+	return best;
+}
+
+/*
+Take jobs until there are none left or the sweep is interrupted
+*/
+void Sweep::work(const std::vector<SweepJob>& jobs) {
+	Solver solver;
+	if (!solver.init(input)) return;
+	if (setup) setup(solver);
+	solver.setStopFlag(stopFlag);
+
+	while (!stopFlag || !stopFlag->load()) {
+		size_t i = next++;
+		if (i >= jobs.size()) break;
+
+		auto start = std::chrono::steady_clock::now();
+		Result result = (solver.*runFunction)(jobs[i].weighting, jobs[i].seed);
+		std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+		SweepRecord r{ jobs[i], result.A, result.D, result.B, result.circleCountAtMax, result.placed, result.stopped, seconds.count() };
+		if (result.circleCountAtMax == -1) {
+			// still recorded, so every job has a record
+			r = SweepRecord{ jobs[i], -1., -1., -1., 0, 0, StopReason::FAILED, seconds.count() };
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		results[i] = r;
+		record(r);
+		if (r.B > best.B) {
+			best = r;
+			if (!output.empty() && !solver.writeOutput(result, output)) {
+				failedWrites++;
+			}
+		}
+	}
+}
+
+/*
+Write the record of a job; the mutex has to be locked
+*/
+void Sweep::record(const SweepRecord& r) {
+	done++;
+	if (!records) return;
+
+	// names can be paths with backslashes
+	std::string name;
+	for (char c : inputName) {
+		if (json && (c == '"' || c == '\\')) name += '\\';
+		name += c;
+	}
+
+	*records << std::setprecision(std::numeric_limits<double>::digits10);
+	if (json) {
+		*records << "{\"input\": \"" << name << "\", \"weighting\": " << r.job.weighting << ", \"seed\": " << r.job.seed
+			<< ", \"B\": " << r.B << ", \"A\": " << r.A << ", \"D\": " << r.D << ", \"circles\": " << r.circles
+			<< ", \"placed\": " << r.placed << ", \"stopped\": \"" << r.stopped << "\", \"seconds\": " << r.seconds << "}";
+	} else {
+		*records << name << "," << r.job.weighting << "," << r.job.seed << "," << r.B << "," << r.A << "," << r.D << ","
+			<< r.circles << "," << r.placed << "," << r.stopped << "," << r.seconds;
+	}
+	// flush every record, so they can be read while the sweep runs
+	*records << std::endl;
+}
+
+/*
+Read jobs from a file with one "WEIGHTING SEED" per line; fails on lines that aren't a job and weightings outside of 0 to 2
+*/
+bool Sweep::parseJobs(const std::string& path, std::vector<SweepJob>& jobs) {
+	std::ifstream file;
+	file.open(path, std::ios::in);
+	if (!file.is_open()) return false;
+
+	double weighting;
+	unsigned seed;
+	while (file >> weighting >> seed) {
+		if (weighting < 0. || weighting > 2.) return false;
+		jobs.push_back(SweepJob{ weighting, seed });
+	}
+	return file.eof();
+}
+
+/*
+Records of the jobs of the last run in their order; B is -1 for jobs that were skipped (NONE as reason) or failed (FAILED)
+*/
+const std::vector<SweepRecord>& Sweep::lastResults() const {
+	return results;
+}
+
+/*
+How often the best result couldn't be written to the output-file in the last run
+*/
+int Sweep::outputFailures() const {
+	return failedWrites;
+}
@@ -0,0 +1,77 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "solver.h"
+
+#include <functional>
+#include <mutex>
+#include <atomic>
+
+struct SweepJob {
+	double weighting;
+	unsigned seed;
+};
+
+/*
+Result of one job of a sweep
+*/
+struct SweepRecord {
+	SweepJob job = SweepJob{ 0., 0 };
+	double A = 0., D = 0., B = -1.;
+	int circles = 0;
+	int placed = 0;
+	StopReason stopped = StopReason::NONE;
+	double seconds = 0.;
+};
+
+/*
+Runs many (weighting, seed)-jobs on one input, which is read only once. Every thread has its own Solver and takes the next job
+whenever it finishes one, so long jobs don't hold up the others. A record of every job is written as soon as it's done
+and the best result so far is kept in the output-file.
+*/
+class Sweep {
+public:
+	Sweep(const Input& input, const std::string& inputName, Solver::RunFunction run);
+
+	// applied to the Solver of every thread before its first job
+	void setSetup(std::function<void(Solver&)> setup);
+	void setThreads(int threads);
+	// records go to out, as JSON-lines if json is set and as CSV otherwise
+	void setRecords(std::ostream* out, bool json);
+	void setOutput(const std::string& path);
+	void setStopFlag(const std::atomic<bool>* flag);
+
+	SweepRecord run(const std::vector<SweepJob>& jobs);
+
+	const std::vector<SweepRecord>& lastResults() const;
+	int outputFailures() const;
+
+	static bool parseJobs(const std::string& path, std::vector<SweepJob>& jobs);
+
+private:
+	void work(const std::vector<SweepJob>& jobs);
+	void record(const SweepRecord& r);
+
+	const Input& input;
+	std::string inputName;
+	Solver::RunFunction runFunction;
+	std::function<void(Solver&)> setup;
+	int threads;
+	std::ostream* records;
+	bool json;
+	std::string output;
+	const std::atomic<bool>* stopFlag;
+	// whether the CSV-header was written
+	bool header;
+
+	// index of the next job that no thread has taken yet
+	std::atomic<size_t> next;
+	// guards records, results, best and the output-file
+	std::mutex mutex;
+	std::vector<SweepRecord> results;
+	SweepRecord best;
+	size_t done;
+	int failedWrites;
+};
+
+#endif
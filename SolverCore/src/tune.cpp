@@ -0,0 +1,145 @@
+#include "tune.h"
+
+#include <cmath>
+
+Tune::Tune(Sweep& sweep, const std::vector<unsigned>& seeds)
+	: sweep(sweep), seeds(seeds), tolerance(0.005), width(2), log(nullptr), stopFlag(nullptr), runCount(0) {
+}
+
+void Tune::setTolerance(double tolerance) {
+	this->tolerance = tolerance;
+}
+
+void Tune::setWidth(int points) {
+	width = std::max(2, points);
+}
+
+void Tune::setLog(std::ostream* log) {
+	this->log = log;
+}
+
+/*
+Ends the search as soon as it's set, after the running jobs returned their best circles so far
+*/
+void Tune::setStopFlag(const std::atomic<bool>* flag) {
+	stopFlag = flag;
+	sweep.setStopFlag(flag);
+}
+
+SweepRecord Tune::run(std::vector<double> grid) {
+	points.clear();
+	bestRun = SweepRecord();
+	best = TunePoint();
+	reason.clear();
+	runCount = 0;
+
+	for (double& w : grid) {
+		w = std::clamp(w, 0., 2.);
+	}
+	std::sort(grid.begin(), grid.end());
+	grid.erase(std::unique(grid.begin(), grid.end()), grid.end());
+	evaluate(grid);
+
+	double lo = 0., hi = 2.;
+	for (int step = 0; ; step++) {
+		// the bracket is spanned by the neighbours of the best weighting in it
+		int bestIndex = -1;
+		for (int i = 0; i < (int)points.size(); i++) {
+			const TunePoint& p = points[i];
+			if (p.runs == 0 || p.weighting < lo || p.weighting > hi) continue;
+			if (bestIndex == -1 || p.mean > points[bestIndex].mean) bestIndex = i;
+		}
+		if (bestIndex == -1) {
+			reason = "no runs";
+			break;
+		}
+		best = points[bestIndex];
+
+		double newLo = best.weighting, newHi = best.weighting;
+		double lowest = best.mean;
+		for (const TunePoint& p : points) {
+			if (p.runs == 0 || p.weighting < lo || p.weighting > hi) continue;
+			if (p.weighting < best.weighting && (newLo == best.weighting || p.weighting > newLo)) newLo = p.weighting;
+			if (p.weighting > best.weighting && (newHi == best.weighting || p.weighting < newHi)) newHi = p.weighting;
+			lowest = std::min(lowest, p.mean);
+		}
+
+		report(step == 0 ? "grid" : "step " + std::to_string(step), best, newLo, newHi);
+
+		if (stopFlag && stopFlag->load()) {
+			reason = "interrupted";
+			break;
+		}
+		if (newHi - newLo < tolerance) {
+			reason = "tolerance";
+			break;
+		}
+		if (step > 0 && best.mean - lowest <= best.error) {
+			reason = "within noise";
+			break;
+		}
+		lo = newLo;
+		hi = newHi;
+
+		std::vector<double> next;
+		for (int i = 1; i <= width; i++) {
+			next.push_back(lo + (hi - lo) * i / (width + 1));
+		}
+		evaluate(next);
+	}
+	return bestRun;
+}
+
+/*
+Run every weighting with all seeds at once and add their means to the points
+*/
+void Tune::evaluate(const std::vector<double>& weightings) {
+	std::vector<SweepJob> jobs;
+	for (double w : weightings) {
+		for (unsigned seed : seeds) {
+			jobs.push_back(SweepJob{ w, seed });
+		}
+	}
+	bestRun = sweep.run(jobs);
+
+	const std::vector<SweepRecord>& results = sweep.lastResults();
+	for (size_t i = 0; i < weightings.size(); i++) {
+		TunePoint p;
+		p.weighting = weightings[i];
+		double sum = 0., sumSquared = 0.;
+		for (size_t j = 0; j < seeds.size(); j++) {
+			const SweepRecord& r = results[i * seeds.size() + j];
+			// an interrupted run would only pull the mean down
+			if (r.B < 0. || r.stopped == StopReason::INTERRUPTED) continue;
+			sum += r.B;
+			sumSquared += r.B * r.B;
+			p.runs++;
+			runCount++;
+		}
+		if (p.runs == 0) continue;
+		p.mean = sum / p.runs;
+		if (p.runs > 1) {
+			double variance = std::max(0., (sumSquared - sum * p.mean) / (p.runs - 1));
+			p.error = std::sqrt(variance / p.runs);
+		}
+		points.push_back(p);
+	}
+}
+
+void Tune::report(const std::string& step, const TunePoint& best, double lo, double hi) {
+	if (!log) return;
+	*log << "Tune " << step << ": mean B=" << best.mean << " +- " << best.error << " at weighting " << best.weighting
+		<< ", bracket [" << lo << ", " << hi << "], best run B=" << bestRun.B << " after " << runCount << " runs" << std::endl;
+}
+
+const TunePoint& Tune::result() const {
+	return best;
+}
+
+const std::string& Tune::stopped() const {
+	return reason;
+}
+
+int Tune::runs() const {
+	return runCount;
+}
@@ -0,0 +1,64 @@
+#ifndef TUNE_H
+#define TUNE_H
+
+#include "sweep.h"
+
+/*
+Mean B of the runs with one weighting over all seeds and the standard error of that mean
+*/
+struct TunePoint {
+	double weighting = 0.;
+	double mean = -1.;
+	double error = 0.;
+	int runs = 0;
+};
+
+/*
+Searches the weighting with the best B averaged over a few seeds, instead of running a dense grid of weightings.
+A coarse grid finds the region of the best weighting, which is then narrowed down by a section-search: every step runs
+a few weightings spread over the bracket around the best one at once (golden-section-search runs one at a time)
+and the bracket shrinks to the neighbours of the best one. Averaging over the seeds keeps it from chasing lucky runs.
+The search ends when the bracket is narrower than the tolerance or when all weightings in it are
+within the noise of the best mean, so that narrowing it further would only follow the noise.
+*/
+class Tune {
+public:
+	Tune(Sweep& sweep, const std::vector<unsigned>& seeds);
+
+	void setTolerance(double tolerance);
+	// weightings run at once per step, at least 2
+	void setWidth(int points);
+	// every step, none if null
+	void setLog(std::ostream* log);
+	void setStopFlag(const std::atomic<bool>* flag);
+
+	/*
+	Search starting with the weightings of the grid; returns the best single run of the search (B is -1 if there was none)
+	*/
+	SweepRecord run(std::vector<double> grid);
+
+	// best weighting by its mean, why the search ended and how many runs it took
+	const TunePoint& result() const;
+	const std::string& stopped() const;
+	int runs() const;
+
+private:
+	void evaluate(const std::vector<double>& weightings);
+	void report(const std::string& step, const TunePoint& best, double lo, double hi);
+
+	Sweep& sweep;
+	std::vector<unsigned> seeds;
+	double tolerance;
+	int width;
+	std::ostream* log;
+	const std::atomic<bool>* stopFlag;
+
+	// every weighting run so far, in order
+	std::vector<TunePoint> points;
+	SweepRecord bestRun;
+	TunePoint best;
+	std::string reason;
+	int runCount;
+};
+
+#endif
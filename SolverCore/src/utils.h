@@ -0,0 +1,376 @@
+#ifndef UTILS_H
+#define UTILS_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <iostream>
+#include <cmath>
+#include <iomanip>
+#include <unordered_map>
+#include <array>
+#include <limits>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <set>
+#include "overlap.h"
+
+#define PI 3.1415926535897932384626433832795028841971
+#define RADIUS_EPSILON 0.0000001
+
+struct Connection;
+
+struct CircleType {
+	int index;
+	double r;
+	double sizeMultiplier;
+
+	CircleType(int index, double r)
+		: index(index), r(r), sizeMultiplier(0.) {
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const CircleType& ct) {
+		return os << "<CircleType " << ct.index << " r=" << ct.r << ">";
+	}
+};
+
+/*
+All circle-types with the same radius. Their circles are interchangeable, so the solver only places circles of a radius
+and hands out the types of the class in turn. That keeps the counts of the types as equal as possible
+after every circle, which is the best split for the diversity.
+*/
+struct RadiusClass {
+	int radiusIndex;
+	double r;
+	std::vector<int> typeIndices;
+	int count = 0;
+
+	RadiusClass(int radiusIndex, double r) : radiusIndex(radiusIndex), r(r) {}
+
+	/*
+	Type of the next circle
+	*/
+	int nextType() const {
+		return typeIndices[count % typeIndices.size()];
+	}
+
+};
+
+struct Input {
+	std::string name;
+	double w = 0., h = 0.;
+	std::vector<CircleType> types;
+};
+
+struct Point {
+	double x, y;
+
+	friend std::ostream& operator<<(std::ostream& os, const Point& p) {
+		return os << "(" << p.x << ";" << p.y << ")";
+	}
+};
+
+enum class ConnType : unsigned char {
+	CORNER,
+	WALL,
+	CIRCLE
+};
+
+enum class Wall {
+	UP, RIGHT, DOWN, LEFT
+};
+
+enum class Corner {
+	TL, TR, BL, BR
+};
+
+struct Connection;
+
+struct Circle {
+	int index;
+	int typeIndex;
+	double cx, cy, r;
+	Circle(double cx, double cy, double r) : index(0), typeIndex(0), cx(cx), cy(cy), r(r) {}
+
+	friend std::ostream& operator<<(std::ostream& os, const Circle& c) {
+		os << "<Circle cx=" << c.cx << " cy=" << c.cy << " r=" << c.r << ">";
+		return os;
+	}
+};
+
+/*
+Owns the placed circles. Positions and radii are kept in contiguous arrays for the overlap-kernel.
+*/
+struct CircleStore : CircleBlock {
+	std::vector<int> typeIndex;
+	std::vector<int> index;
+
+	void push(const Circle& c) {
+		CircleBlock::push(c.cx, c.cy, c.r);
+		typeIndex.push_back(c.typeIndex);
+		index.push_back(c.index);
+	}
+
+	void clear() {
+		CircleBlock::clear();
+		typeIndex.clear();
+		index.clear();
+	}
+
+	Circle get(int i) const {
+		Circle c(cx[i], cy[i], r[i]);
+		c.index = index[i];
+		c.typeIndex = typeIndex[i];
+		return c;
+	}
+};
+
+/*
+Tagged record of a connection, stored in a ConnectionPool and addressed by its index
+*/
+struct Connection {
+	// largest radius that fits, see FitSet for all of them
+	double maxRadius = 0;
+	// position of the smallest circle, calculated on the first evaluation
+	Point minPos = Point{0., 0.};
+	int c1;
+	union {
+		int c2;
+		Wall wall = Wall::LEFT;
+		Corner corner;
+	};
+	int radiusIndex = -1;
+	int gridCell = -1;
+	int gridSlot = -1;
+	// number of placed circles when the fits were calculated
+	int epoch = 0;
+	ConnType type;
+	bool left = true;
+	bool minPosKnown = false;
+	// in the calculated connections
+	bool calculated = false;
+
+	Connection(int c1, int c2, bool left)
+		: c1(c1), c2(c2), type(ConnType::CIRCLE), left(left) { }
+
+	Connection(int c1, Wall wall, bool left)
+		: c1(c1), wall(wall), type(ConnType::WALL), left(left) { }
+
+	Connection(Corner corner)
+		: c1(-1), corner(corner), type(ConnType::CORNER) { }
+
+	/*
+	Identity of the connection: connections with equal keys place circles at the same position for every radius.
+	The circle-connection from a to b on the left side is the same as the one from b to a on the right side.
+	*/
+	std::tuple<ConnType, int, int, bool> key() const {
+		if (type == ConnType::CORNER) return { type, -1, (int)corner, true };
+		if (type == ConnType::WALL) return { type, c1, (int)wall, left };
+		if (c1 > c2) return { type, c2, c1, !left };
+		return { type, c1, c2, left };
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const Connection& c) {
+		os << "<Connection ";
+		if (c.type == ConnType::CIRCLE) {
+			os << "Circle " << c.c2 << ">";
+		} else if (c.type == ConnType::WALL) {
+			os << "Wall ";
+			if (c.wall == Wall::DOWN) os << "DOWN";
+			else if (c.wall == Wall::LEFT) os << "LEFT";
+			else if (c.wall == Wall::RIGHT) os << "RIGHT";
+			else if (c.wall == Wall::UP) os << "UP";
+		} else if (c.type == ConnType::CORNER) {
+			os << "Corner ";
+			if (c.corner == Corner::TL) os << "TL";
+			else if (c.corner == Corner::TR) os << "TR";
+			else if (c.corner == Corner::BL) os << "BL";
+			else if (c.corner == Corner::BR) os << "BR";
+		}
+		os << " mr=" << c.maxRadius;
+		os << " left=" << c.left;
+		os << ">";
+		return os;
+	}
+};
+
+/*
+Owns all connections of a run. Released slots are reused, and clear() keeps the memory for the next run,
+so placing circles doesn't allocate once the pool has grown.
+*/
+struct ConnectionPool {
+	std::vector<Connection> conns;
+	std::vector<int> freeIds;
+
+	int add(const Connection& conn) {
+		if (freeIds.empty()) {
+			conns.push_back(conn);
+			return (int)conns.size() - 1;
+		}
+		int id = freeIds.back();
+		freeIds.pop_back();
+		conns[id] = conn;
+		return id;
+	}
+
+	void release(int id) {
+		freeIds.push_back(id);
+	}
+
+	void clear() {
+		conns.clear();
+		freeIds.clear();
+	}
+
+	Connection& operator[](int id) {
+		return conns[id];
+	}
+
+	const Connection& operator[](int id) const {
+		return conns[id];
+	}
+};
+
+/*
+A circle that can be placed together with the four connections it creates
+*/
+struct PossibleCircle  {
+	Circle circle;
+	std::array<Connection, 4> conns;
+
+	PossibleCircle(Circle circle, std::array<Connection, 4> conns)
+		: circle(circle), conns(conns) { }
+};
+
+/*
+Why a run ended; NONE if it didn't run, FAILED if it couldn't start
+*/
+enum class StopReason {
+	NONE,
+	NO_CONNECTIONS,
+	CONVERGED,
+	CIRCLE_LIMIT,
+	TIME_LIMIT,
+	INTERRUPTED,
+	FAILED
+};
+
+/*
+Text of a stop-reason for logs and records
+*/
+inline std::ostream& operator<<(std::ostream& os, StopReason reason) {
+	switch (reason) {
+	case StopReason::NONE: return os << "not run";
+	case StopReason::NO_CONNECTIONS: return os << "no connections left";
+	case StopReason::CONVERGED: return os << "converged";
+	case StopReason::CIRCLE_LIMIT: return os << "circle limit";
+	case StopReason::TIME_LIMIT: return os << "time limit";
+	case StopReason::INTERRUPTED: return os << "interrupted";
+	case StopReason::FAILED: return os << "failed";
+	}
+	return os;
+}
+
+struct Result {
+	std::vector<Circle> circles;
+	double A, D, B;
+	int circleCountAtMax;
+	// why the run ended and how many circles it placed until then
+	StopReason stopped = StopReason::FAILED;
+	int placed = 0;
+
+	Result(std::vector<Circle> circles, double A, double D, double B, int circleCountAtMax)
+		: circles(circles), A(A), D(D), B(B), circleCountAtMax(circleCountAtMax) {}
+
+	Result() : A(-1.), D(-1.), B(-1.), circleCountAtMax(-1) {}
+};
+
+inline Point intersectionTwoCircles(double cx1, double cy1, double cr1, double cx2, double cy2, double cr2) {
+	double dx = cx2 - cx1;
+	double dy = cy2 - cy1;
+	double d = std::sqrt(dx * dx + dy * dy);
+	double a = (cr1 * cr1 - cr2 * cr2 + d * d) / (2. * d);
+	double h = std::sqrt(cr1 * cr1 - a * a);
+
+	double x3 = cx1 + (a * dx + h * dy) / d;
+	double y3 = cy1 + (a * dy - h * dx) / d;
+
+	return Point{x3, y3};
+}
+
+/*
+Smallest x >= lo at which a * x^2 + b * x + c changes from positive to negative.
+Returns infinity if that never happens.
+*/
+inline double firstNegative(double a, double b, double c, double lo) {
+	double first = std::numeric_limits<double>::infinity();
+	auto check = [&](double x) {
+		// roots slightly below lo are rounding errors of a circle touching at lo
+		if (x >= lo - RADIUS_EPSILON && 2. * a * x + b < 0.) first = std::min(first, std::max(x, lo));
+	};
+	if (a == 0.) {
+		if (b != 0.) check(-c / b);
+		return first;
+	}
+	double disc = b * b - 4. * a * c;
+	// no roots or only touching
+	if (disc <= 0.) return first;
+	double q = -0.5 * (b + std::copysign(std::sqrt(disc), b));
+	check(q / a);
+	if (q != 0.) check(c / q);
+	return first;
+}
+
+/*
+Smallest radius r >= lo at which the circle touching c1 and c2 also touches a circle or line.
+Coordinates are relative to c1. The center of the circle touching c1 (radius r1) and c2 is on the line
+x2 * x + y2 * y = e2 + f2 * r. The circle or line is given by a * x + b * y = e + f * r.
+Only centers on the side chosen by intersectionTwoCircles(c1, c2) count.
+*/
+inline double firstTouchTwoCircles(double x2, double y2, double e2, double f2, double r1, double a, double b, double e, double f, double lo) {
+	double first = std::numeric_limits<double>::infinity();
+	double det = x2 * b - y2 * a;
+	if (std::abs(det) <= 1e-9 * std::sqrt((x2 * x2 + y2 * y2) * (a * a + b * b))) {
+		// parallel lines: both only meet at one radius
+		double l = (a * x2 + b * y2) / (x2 * x2 + y2 * y2);
+		double denom = f - l * f2;
+		if (denom == 0.) return first;
+		double r = (l * e2 - e) / denom;
+		return r >= lo - RADIUS_EPSILON ? std::max(r, lo) : first;
+	}
+
+	// center (px + qx * r; py + qy * r) put into x^2 + y^2 = (r + r1)^2
+	double px = (e2 * b - y2 * e) / det, qx = (f2 * b - y2 * f) / det;
+	double py = (x2 * e - a * e2) / det, qy = (x2 * f - a * f2) / det;
+	double qa = qx * qx + qy * qy - 1.;
+	double qb = 2. * (px * qx + py * qy - r1);
+	double qc = px * px + py * py - r1 * r1;
+
+	auto check = [&](double r) {
+		if (r < lo - RADIUS_EPSILON) return;
+		// intersectionTwoCircles puts the center right of c1 -> c2
+		if (x2 * (py + qy * r) - y2 * (px + qx * r) > 0.) return;
+		first = std::min(first, std::max(r, lo));
+	};
+	if (qa == 0.) {
+		if (qb != 0.) check(-qc / qb);
+		return first;
+	}
+	double disc = qb * qb - 4. * qa * qc;
+	if (disc < 0.) return first;
+	double q = -0.5 * (qb + std::copysign(std::sqrt(disc), qb));
+	check(q / qa);
+	if (q != 0.) check(qc / q);
+	return first;
+}
+
+// Construct circle touching two circles
+inline Circle circleFromTwoCircles(const Circle& c1, const Circle& c2, double r) {
+	auto p = intersectionTwoCircles(c1.cx, c1.cy, c1.r + r, c2.cx, c2.cy, c2.r + r);
+	return Circle(p.x, p.y, r);
+}
+
+#endif
\ No newline at end of file
@@ -4,6 +4,11 @@ IncludeDir.SDL = "%{wks.location}/dependencies/SDL2/include"
 LibraryDir = {}
 LibraryDir.SDL = "%{wks.location}/dependencies/SDL2/lib"
 
+newoption {
+    trigger = "avx2",
+    description = "Use AVX2 for the overlap-kernel of the Solver (SSE2 otherwise)"
+}
+
 workspace "md_2023"
     startproject "Solver"
     architecture "x86_64"
@@ -15,10 +20,12 @@ workspace "md_2023"
 
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
+include "SolverCore"
 include "Solver"
 include "Display"
 include "Scramble"
 include "ImageFromCircles"
 include "ImageFromTypes"
 include "FrameAnimation"
-include "Checker"
\ No newline at end of file
+include "Checker"
+include "Benchmark"
\ No newline at end of file